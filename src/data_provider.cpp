@@ -0,0 +1,318 @@
+#include "data_provider.hpp"
+#include "priceseries.hpp"
+#include "python_worker.hpp"
+#include "random_utils.hpp"
+#include "thread_utils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+void DataProvider::fetchBatch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval,
+                              const std::function<void(std::size_t, PriceData&)>& onData) const {
+    for (std::size_t i = 0; i < tickers.size(); ++i) {
+        PriceData data = fetch(tickers[i], start, end, interval);
+        onData(i, data);
+    }
+}
+
+// Yahoo ------------------------------------------------------------------------
+static PriceData toPriceData(matplotlibcpp::scraped_series& series) {
+    PriceData data;
+    data.dates = std::move(series.dates);
+    wallClockToEpoch(data.dates.data(), data.dates.size(), data.dates.data());
+    data.opens = std::move(series.opens);
+    data.highs = std::move(series.highs);
+    data.lows = std::move(series.lows);
+    data.closes = std::move(series.closes);
+    data.adjCloses = std::move(series.adj_closes);
+    data.volumes = std::move(series.volumes);
+    return data;
+}
+
+PriceData YahooProvider::fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string&) const {
+    matplotlibcpp::scraped_series series;
+    matplotlibcpp::scrape(ticker, epochToDateString(start), epochToDateString(end),
+                          series.dates, series.opens, series.highs, series.lows, series.closes, series.adj_closes, series.volumes);
+    return toPriceData(series);
+}
+
+void YahooProvider::fetchBatch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string&,
+                               const std::function<void(std::size_t, PriceData&)>& onData) const {
+    matplotlibcpp::scrape_batch(tickers, epochToDateString(start), epochToDateString(end),
+        [&](std::size_t i, matplotlibcpp::scraped_series& series) {
+            PriceData data = toPriceData(series);
+            onData(i, data);
+        });
+}
+
+// CSV --------------------------------------------------------------------------
+CSVProvider::CSVProvider(const std::string& directory, const char delimiter)
+    : directory(directory), delimiter(delimiter) {}
+
+PriceData CSVProvider::fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string&) const {
+    const std::string path = fmt::format("{}/{}.csv", directory, ticker);
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file {}", path));
+    }
+
+    PriceData data;
+    std::string line;
+    std::vector<std::string> fields;
+    std::size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        // Skip blank lines and a header row
+        if (line.empty() || !std::isdigit(static_cast<unsigned char>(line[0]))) {
+            continue;
+        }
+
+        fields.clear();
+        std::size_t from = 0;
+        for (std::size_t to = line.find(delimiter); fields.size() < 7; to = line.find(delimiter, from)) {
+            fields.push_back(line.substr(from, to - from));
+            if (to == std::string::npos) {
+                break;
+            }
+            from = to + 1;
+        }
+        if (fields.size() < 7) {
+            throw std::runtime_error(fmt::format("Could not load prices: {} line {} has too few columns", path, lineNumber));
+        }
+
+        std::time_t date = dateStringToEpoch(fields[0]);
+        if (date < start || date >= end) {
+            continue;
+        }
+        try {
+            data.dates.push_back(date);
+            data.opens.push_back(std::stod(fields[1]));
+            data.highs.push_back(std::stod(fields[2]));
+            data.lows.push_back(std::stod(fields[3]));
+            data.closes.push_back(std::stod(fields[4]));
+            data.adjCloses.push_back(std::stod(fields[5]));
+            data.volumes.push_back(std::stol(fields[6]));
+        } catch (const std::logic_error&) {
+            throw std::runtime_error(fmt::format("Could not load prices: {} line {} is not numeric", path, lineNumber));
+        }
+    }
+    return data;
+}
+
+// Binary -----------------------------------------------------------------------
+struct PriceFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(PriceFileHeader) == 16, "Price file header must be packed");
+static_assert(sizeof(std::time_t) == sizeof(std::int64_t) && sizeof(long) == sizeof(std::int64_t),
+              "Price files store dates and volumes as 64-bit integers");
+
+void writePriceData(const std::string& path, const PriceData& data) {
+    const std::size_t n = data.dates.size();
+    if (data.opens.size() != n || data.highs.size() != n || data.lows.size() != n ||
+        data.closes.size() != n || data.adjCloses.size() != n || data.volumes.size() != n) {
+        throw std::invalid_argument("Could not save prices: columns have different lengths");
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file {}", path));
+    }
+    PriceFileHeader header = {{}, PRICE_FILE_VERSION, n};
+    std::copy(PRICE_FILE_MAGIC, PRICE_FILE_MAGIC + 4, header.magic);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.dates.data()), n * sizeof(std::time_t));
+    for (const auto* column : {&data.opens, &data.highs, &data.lows, &data.closes, &data.adjCloses}) {
+        file.write(reinterpret_cast<const char*>(column->data()), n * sizeof(double));
+    }
+    file.write(reinterpret_cast<const char*>(data.volumes.data()), n * sizeof(long));
+    if (!file) {
+        throw std::runtime_error("Could not save prices: write failed");
+    }
+}
+
+PriceData readPriceData(const std::string& path, const std::time_t start, const std::time_t end) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file {}", path));
+    }
+
+    PriceFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error(fmt::format("Could not load prices: {} is too short for a header", path));
+    }
+    if (!std::equal(PRICE_FILE_MAGIC, PRICE_FILE_MAGIC + 4, header.magic)) {
+        throw std::runtime_error("Could not load prices: not a price file");
+    }
+    if (header.version != PRICE_FILE_VERSION) {
+        throw std::runtime_error(fmt::format("Could not load prices: unsupported version {}", header.version));
+    }
+
+    // Dates are read in full to find the range, then only that slice of
+    // every other column
+    const std::size_t n = header.count;
+    std::vector<std::time_t> dates(n);
+    file.read(reinterpret_cast<char*>(dates.data()), n * sizeof(std::time_t));
+    const std::size_t first = std::lower_bound(dates.begin(), dates.end(), start) - dates.begin();
+    const std::size_t last = std::max(first, static_cast<std::size_t>(std::lower_bound(dates.begin(), dates.end(), end) - dates.begin()));
+    const std::size_t count = last - first;
+
+    PriceData data;
+    data.dates.assign(dates.begin() + first, dates.begin() + last);
+    const std::streamoff columnsStart = sizeof(header) + n * sizeof(std::time_t);
+    std::size_t column = 0;
+    for (auto* values : {&data.opens, &data.highs, &data.lows, &data.closes, &data.adjCloses}) {
+        values->resize(count);
+        file.seekg(columnsStart + (column++ * n + first) * sizeof(double));
+        file.read(reinterpret_cast<char*>(values->data()), count * sizeof(double));
+    }
+    data.volumes.resize(count);
+    file.seekg(columnsStart + (column * n + first) * sizeof(double));
+    file.read(reinterpret_cast<char*>(data.volumes.data()), count * sizeof(long));
+    if (!file) {
+        throw std::runtime_error("Could not load prices: file is truncated");
+    }
+    return data;
+}
+
+BinaryProvider::BinaryProvider(const std::string& directory)
+    : directory(directory) {}
+
+PriceData BinaryProvider::fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string&) const {
+    return readPriceData(fmt::format("{}/{}.bin", directory, ticker), start, end);
+}
+
+// Synthetic --------------------------------------------------------------------
+SyntheticProvider::SyntheticProvider(double startPrice, double drift, double volatility, std::uint64_t seed)
+    : startPrice(startPrice), drift(drift), volatility(volatility), seed(seed) {
+    if (startPrice <= 0 || volatility < 0) {
+        throw std::invalid_argument("Could not create synthetic provider. Start price must be positive and volatility non-negative");
+    }
+}
+
+PriceData SyntheticProvider::fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) const {
+    const std::time_t step = intervalToSeconds(interval);
+    if (step <= 0) {
+        throw std::invalid_argument("Could not fetch synthetic prices. Interval " + interval + " is not supported");
+    }
+
+    Xoshiro256 rng(seed, std::hash<std::string>()(ticker));
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    PriceData data;
+    double close = startPrice;
+    for (std::time_t date = start; date < end; date += step) {
+        const double open = close;
+        close = open * std::exp(drift + volatility * normal(rng));
+        const double wick = volatility * std::abs(normal(rng)) / 2;
+        data.dates.push_back(date);
+        data.opens.push_back(open);
+        data.highs.push_back(std::max(open, close) * (1 + wick));
+        data.lows.push_back(std::min(open, close) * (1 - wick));
+        data.closes.push_back(close);
+        data.adjCloses.push_back(close);
+        data.volumes.push_back(static_cast<long>(1e6 * (1 + rng.uniform())));
+    }
+    return data;
+}
+
+// Prefetcher -------------------------------------------------------------------
+Prefetcher::Prefetcher(std::shared_ptr<DataProvider> provider, unsigned threadCount)
+    : provider(provider ? std::move(provider) : PriceSeries::getDataProvider()) {
+    if (this->provider->usesPython()) {
+        pythonWorker = std::make_unique<PythonWorker>();
+        return;
+    }
+    for (unsigned worker = 0; worker < getThreadCount(threadCount); ++worker) {
+        workers.emplace_back(&Prefetcher::run, this);
+    }
+}
+
+Prefetcher::~Prefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void Prefetcher::run() {
+    while (true) {
+        std::packaged_task<std::unique_ptr<PriceSeries>()> load;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            load = std::move(queue.front());
+            queue.pop_front();
+        }
+        load();
+    }
+}
+
+std::future<std::unique_ptr<PriceSeries>> Prefetcher::startLoad(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) {
+    std::shared_ptr<DataProvider> source = provider;
+    auto load = [source, ticker, start, end, interval] {
+        return PriceSeries::getPriceSeries(*source, ticker, start, end, interval);
+    };
+    if (pythonWorker) {
+        return pythonWorker->submit(load);
+    }
+    std::packaged_task<std::unique_ptr<PriceSeries>()> task(load);
+    std::future<std::unique_ptr<PriceSeries>> result = task.get_future();
+    queue.push_back(std::move(task));
+    ready.notify_one();
+    return result;
+}
+
+void Prefetcher::prefetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Key key(ticker, start, end, interval);
+    if (!loads.count(key)) {
+        loads.emplace(key, startLoad(ticker, start, end, interval));
+    }
+}
+
+void Prefetcher::prefetch(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval) {
+    prefetch(ticker, dateStringToEpoch(start), dateStringToEpoch(end), interval);
+}
+
+void Prefetcher::prefetch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval) {
+    for (const auto& ticker : tickers) {
+        prefetch(ticker, start, end, interval);
+    }
+}
+
+std::unique_ptr<PriceSeries> Prefetcher::get(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) {
+    std::future<std::unique_ptr<PriceSeries>> load;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = loads.find(Key(ticker, start, end, interval));
+        if (it != loads.end()) {
+            load = std::move(it->second);
+            loads.erase(it);
+        } else {
+            load = startLoad(ticker, start, end, interval);
+        }
+    }
+    return load.get();
+}
+
+std::unique_ptr<PriceSeries> Prefetcher::get(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval) {
+    return get(ticker, dateStringToEpoch(start), dateStringToEpoch(end), interval);
+}
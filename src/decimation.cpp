@@ -0,0 +1,47 @@
+#include "decimation.hpp"
+#include "time_utils.hpp"
+
+#include <stdexcept>
+
+OHLCBars decimateOHLC(const std::vector<std::time_t>& dates,
+                      const std::vector<double>& opens,
+                      const std::vector<double>& highs,
+                      const std::vector<double>& lows,
+                      const std::vector<double>& closes,
+                      const std::vector<long>& volumes,
+                      std::size_t bucketCount) {
+    const std::size_t n = dates.size();
+    if (opens.size() != n || highs.size() != n || lows.size() != n || closes.size() != n || volumes.size() != n) {
+        throw std::invalid_argument("Could not decimate bars: columns must have equal lengths");
+    }
+    if (bucketCount == 0) {
+        throw std::invalid_argument("Could not decimate bars: bucket count must be positive");
+    }
+
+    OHLCBars bars;
+    const std::time_t spacing = getMedianSpacing(dates.data(), n);
+    if (n <= bucketCount) {
+        bars = {dates, opens, highs, lows, closes, volumes, static_cast<double>(spacing)};
+        return bars;
+    }
+
+    bars.dates.reserve(bucketCount);
+    bars.opens.reserve(bucketCount);
+    bars.highs.reserve(bucketCount);
+    bars.lows.reserve(bucketCount);
+    bars.closes.reserve(bucketCount);
+    bars.volumes.reserve(bucketCount);
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        const std::size_t start = bucket * n / bucketCount;
+        const std::size_t end = (bucket + 1) * n / bucketCount;
+        bars.dates.push_back(dates[start] + (dates[end - 1] - dates[start]) / 2);
+        bars.opens.push_back(opens[start]);
+        bars.closes.push_back(closes[end - 1]);
+        bars.highs.push_back(*std::max_element(highs.begin() + start, highs.begin() + end));
+        bars.lows.push_back(*std::min_element(lows.begin() + start, lows.begin() + end));
+        bars.volumes.push_back(std::accumulate(volumes.begin() + start, volumes.begin() + end, 0L));
+    }
+    // Each bar spans half a spacing either side of its date
+    bars.width = static_cast<double>(dates.back() - dates.front() + spacing) / bucketCount;
+    return bars;
+}
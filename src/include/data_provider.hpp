@@ -0,0 +1,148 @@
+#pragma once
+
+#ifndef DATA_PROVIDER_HPP
+#define DATA_PROVIDER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+class PriceSeries;
+class PythonWorker;
+
+// Price columns of one ticker, oldest bar first
+struct PriceData {
+    std::vector<std::time_t> dates;
+    std::vector<double> opens;
+    std::vector<double> highs;
+    std::vector<double> lows;
+    std::vector<double> closes;
+    std::vector<double> adjCloses;
+    std::vector<long> volumes;
+};
+
+// Source of price bars for PriceSeries. Ranges are [start, end).
+class DataProvider {
+public:
+    virtual ~DataProvider() = default;
+
+    virtual PriceData fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) const = 0;
+    // Call onData(i, data) for tickers[i] as each ticker's data is ready,
+    // by default one fetch per ticker
+    virtual void fetchBatch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval,
+                            const std::function<void(std::size_t, PriceData&)>& onData) const;
+    // Providers that call into the embedded interpreter are only used from
+    // the thread that holds it
+    virtual bool usesPython() const { return false; }
+};
+
+// Yahoo Finance via yfinance in the embedded interpreter
+class YahooProvider : public DataProvider {
+public:
+    PriceData fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) const override;
+    // One download request for every ticker
+    void fetchBatch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval,
+                    const std::function<void(std::size_t, PriceData&)>& onData) const override;
+    bool usesPython() const override { return true; }
+};
+
+// Directory of <ticker>.csv files in the PriceSeries::exportCSV layout:
+// date, open, high, low, close, adj close, volume, then any overlay columns
+class CSVProvider : public DataProvider {
+private:
+    std::string directory;
+    char delimiter;
+
+public:
+    explicit CSVProvider(const std::string& directory, const char delimiter = ',');
+    PriceData fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) const override;
+};
+
+// Versioned binary price file, native endian with 8-byte aligned columns:
+//   header  char magic[4], uint32 version, uint64 bar count
+//   body    int64 dates, double opens, highs, lows, closes, adj closes,
+//           int64 volumes, each column stored contiguously
+constexpr char PRICE_FILE_MAGIC[4] = {'C', 'P', 'F', 'P'};
+constexpr std::uint32_t PRICE_FILE_VERSION = 1;
+
+void writePriceData(const std::string& path, const PriceData& data);
+// Only the bars in [start, end) are read
+PriceData readPriceData(const std::string& path, const std::time_t start, const std::time_t end);
+
+// Directory of <ticker>.bin files written by writePriceData
+class BinaryProvider : public DataProvider {
+private:
+    std::string directory;
+
+public:
+    explicit BinaryProvider(const std::string& directory);
+    PriceData fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) const override;
+};
+
+// Geometric Brownian motion bars spaced one interval apart from start.
+// Each ticker gets its own random stream, so the same arguments always
+// give the same bars.
+class SyntheticProvider : public DataProvider {
+private:
+    double startPrice;
+    double drift;      // Mean log return per bar
+    double volatility; // Standard deviation of log returns per bar
+    std::uint64_t seed;
+
+public:
+    explicit SyntheticProvider(double startPrice = 100.0, double drift = 0.0, double volatility = 0.01, std::uint64_t seed = 0);
+    PriceData fetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) const override;
+};
+
+// Loads PriceSeries in the background so the caller can compute on the
+// current ones while upcoming tickers or date ranges arrive. Loads for
+// providers that use Python run on a PythonWorker, so the constructing
+// thread must not call into Python directly while the prefetcher lives and
+// must be the thread that destroys it.
+class Prefetcher {
+private:
+    using Key = std::tuple<std::string, std::time_t, std::time_t, std::string>;
+
+    std::shared_ptr<DataProvider> provider;
+    std::unique_ptr<PythonWorker> pythonWorker;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable ready; // Loads queued or stopping
+    std::deque<std::packaged_task<std::unique_ptr<PriceSeries>()>> queue;
+    bool stopping = false;
+    std::map<Key, std::future<std::unique_ptr<PriceSeries>>> loads;
+
+    void run();
+    // Queue a load, with mutex held
+    std::future<std::unique_ptr<PriceSeries>> startLoad(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval);
+
+public:
+    // Defaults to the provider PriceSeries currently fetches from
+    explicit Prefetcher(std::shared_ptr<DataProvider> provider = nullptr, unsigned threadCount = 0);
+    // Waits for running loads, queued ones are dropped
+    ~Prefetcher();
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    // Start loading a series unless it is already loading
+    void prefetch(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval = "1d");
+    void prefetch(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval = "1d");
+    void prefetch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval = "1d");
+
+    // Take a series, waiting for its load to finish or loading it now if it
+    // was never prefetched. Load errors are rethrown here.
+    std::unique_ptr<PriceSeries> get(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval = "1d");
+    std::unique_ptr<PriceSeries> get(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval = "1d");
+};
+
+#endif // DATA_PROVIDER_HPP
@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef DECIMATION_HPP
+#define DECIMATION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <numeric>
+#include <vector>
+
+// Points kept per plotted line, about the pixel width of a 1200px figure.
+// Candles need a few pixels each so get a quarter as many buckets.
+constexpr std::size_t PLOT_POINTS = 1200;
+constexpr std::size_t PLOT_CANDLES = PLOT_POINTS / 4;
+
+// Indices of the threshold points of a line chosen by Largest-Triangle-Three-
+// Buckets. The first and last points are always kept, and each bucket in
+// between keeps the point forming the largest triangle with the previous
+// choice and the next bucket's mean. Every index when the line is already
+// short enough.
+template <typename X>
+std::vector<std::size_t> getLTTBIndices(const std::vector<X>& xs, const std::vector<double>& ys, std::size_t threshold) {
+    const std::size_t n = ys.size();
+    std::vector<std::size_t> indices;
+    if (threshold >= n || threshold < 3) {
+        indices.resize(n);
+        std::iota(indices.begin(), indices.end(), 0);
+        return indices;
+    }
+
+    indices.reserve(threshold);
+    indices.push_back(0);
+    const double bucketSize = static_cast<double>(n - 2) / (threshold - 2);
+    std::size_t previous = 0;
+    for (std::size_t bucket = 0; bucket < threshold - 2; ++bucket) {
+        const std::size_t start = static_cast<std::size_t>(bucket * bucketSize) + 1;
+        const std::size_t end = static_cast<std::size_t>((bucket + 1) * bucketSize) + 1;
+
+        // Mean of the next bucket, the last point after the final bucket
+        const std::size_t nextEnd = std::min(static_cast<std::size_t>((bucket + 2) * bucketSize) + 1, n);
+        double meanX = 0.0;
+        double meanY = 0.0;
+        for (std::size_t i = end; i < nextEnd; ++i) {
+            meanX += static_cast<double>(xs[i]);
+            meanY += ys[i];
+        }
+        meanX /= nextEnd - end;
+        meanY /= nextEnd - end;
+
+        // Twice the triangle area, relative to the previous choice
+        const double previousX = static_cast<double>(xs[previous]);
+        const double previousY = ys[previous];
+        double maxArea = -1.0;
+        std::size_t chosen = start;
+        for (std::size_t i = start; i < end; ++i) {
+            double area = std::abs((previousX - meanX) * (ys[i] - previousY) - (previousX - static_cast<double>(xs[i])) * (meanY - previousY));
+            if (area > maxArea) {
+                maxArea = area;
+                chosen = i;
+            }
+        }
+        indices.push_back(chosen);
+        previous = chosen;
+    }
+    indices.push_back(n - 1);
+    return indices;
+}
+
+// Values at the given indices
+template <typename T>
+std::vector<T> takeIndices(const std::vector<T>& values, const std::vector<std::size_t>& indices) {
+    std::vector<T> taken;
+    taken.reserve(indices.size());
+    for (std::size_t i : indices) {
+        taken.push_back(values[i]);
+    }
+    return taken;
+}
+
+// Decimate a line to threshold points in place
+template <typename X>
+void decimateLTTB(std::vector<X>& xs, std::vector<double>& ys, std::size_t threshold = PLOT_POINTS) {
+    if (ys.size() <= threshold) {
+        return;
+    }
+    std::vector<std::size_t> indices = getLTTBIndices(xs, ys, threshold);
+    xs = takeIndices(xs, indices);
+    ys = takeIndices(ys, indices);
+}
+
+// Bars merged into buckets of consecutive bars, each opening at its first
+// bar, closing at its last and spanning their highs, lows and total volume
+struct OHLCBars {
+    std::vector<std::time_t> dates; // Middle of each bucket's first and last bar, bars are drawn centred
+    std::vector<double> opens;
+    std::vector<double> highs;
+    std::vector<double> lows;
+    std::vector<double> closes;
+    std::vector<long> volumes;
+    double width;                   // Seconds covered by a bucket, for bar widths
+};
+
+// Merge bars into at most bucketCount buckets of equal bar counts. Bars are
+// kept as they are, with the median spacing of dates as width, when there
+// are few enough.
+OHLCBars decimateOHLC(const std::vector<std::time_t>& dates,
+                      const std::vector<double>& opens,
+                      const std::vector<double>& highs,
+                      const std::vector<double>& lows,
+                      const std::vector<double>& closes,
+                      const std::vector<long>& volumes,
+                      std::size_t bucketCount = PLOT_CANDLES);
+
+#endif // DECIMATION_HPP
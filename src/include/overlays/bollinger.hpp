@@ -13,7 +13,6 @@ private:
     int period;
     double numStdDev;
     MovingAverageType maType;
-    std::map<std::time_t, std::tuple<double, double, double>> data;
 
 public:
     BollingerBands(std::shared_ptr<PriceSeries> priceSeries, int period = 20, double numStdDev = 2, MovingAverageType maType = MovingAverageType::SMA);
@@ -21,8 +20,6 @@ public:
     void checkArguments() override;
     void calculate() override;
     void plot() const override;
-    TimeSeries<std::vector<double>> getDataMap() const override;
-    std::vector<std::vector<std::string>> getTableData() const override;
 };
 
 #endif // BOLLINGER_HPP
\ No newline at end of file
@@ -11,7 +11,6 @@ class EMA : public IOverlay {
 private:
     int period;
     double smoothingFactor;
-    TimeSeries<double> data;
 
 public:
     EMA(std::shared_ptr<PriceSeries> priceSeries, int period = 20, double smoothingFactor = -1);
@@ -19,10 +18,9 @@ public:
     void checkArguments() override;
     void calculate() override;
     void plot() const override;
-    TimeSeries<std::vector<double>> getDataMap() const override;
-    std::vector<std::vector<std::string>> getTableData() const override;
 
     const TimeSeries<double> getData() const;
+    const std::vector<double>& getValues() const;
 };
 
 #endif // EMA_HPP
\ No newline at end of file
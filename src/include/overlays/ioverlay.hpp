@@ -14,6 +14,7 @@
 #include "time_utils.hpp"
 #include "types.hpp"
 #include "print_utils.hpp"
+#include "decimation.hpp"
 #include "../../../third_party/matplotlibcpp.h"
 
 class PriceSeries;
@@ -21,11 +22,18 @@ class PriceSeries;
 class IOverlay {
 protected:
     std::shared_ptr<PriceSeries> priceSeries;
+    // Bar of the parent series the first value belongs to, bars before it
+    // are the warm-up period. Value i belongs to bar startIndex + i.
+    std::size_t startIndex = 0;
+    // Output columns named by columnHeaders after the date, each holding
+    // one value per bar from startIndex
+    std::vector<std::vector<double>> columns;
     
     // Table printing values 
     std::string name;
     std::vector<std::string> columnHeaders;
     std::vector<int> columnWidths;
+    int precision = 2;
 
 public:
     IOverlay() = default;
@@ -38,10 +46,17 @@ public:
     virtual void checkArguments() = 0;
     virtual void calculate() = 0;
     virtual void plot() const = 0;
+    virtual std::vector<std::vector<std::string>> getTableData() const;
+
+    std::size_t getStartIndex() const { return startIndex; }
+    // Number of values in each column
+    std::size_t getLength() const { return columns.empty() ? 0 : columns.front().size(); }
+    std::size_t getWidth() const { return columns.size(); }
+    const std::vector<std::vector<double>>& getColumns() const { return columns; }
+    const std::vector<double>& getColumn(std::size_t j) const { return columns.at(j); }
+    const std::string& getColumnName(std::size_t j) const { return columnHeaders.at(j + 1); }
     // Get map where each row of data is a vector
-    // used for printing price series with overlays
-    virtual TimeSeries<std::vector<double>> getDataMap() const = 0;
-    virtual std::vector<std::vector<std::string>> getTableData() const = 0;
+    TimeSeries<std::vector<double>> getDataMap() const;
 
     const std::string getName() const { return name; }
     const std::vector<std::string> getColumnHeaders() const { return columnHeaders; }
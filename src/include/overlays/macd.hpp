@@ -11,7 +11,6 @@ class PriceSeries;
 class MACD : public IOverlay {
 private:
     int aPeriod, bPeriod, cPeriod;
-    TimeSeries<std::tuple<double, double, double>> data;
 
 public:
     MACD(std::shared_ptr<PriceSeries> priceSeries, int aPeriod = 12, int bPeriod = 26, int cPeriod = 9);
@@ -19,8 +18,6 @@ public:
     void checkArguments() override;
     void calculate() override;
     void plot() const override;
-    TimeSeries<std::vector<double>> getDataMap() const override;
-    std::vector<std::vector<std::string>> getTableData() const override;
 };
 
 #endif // MACD_HPP
\ No newline at end of file
@@ -10,7 +10,6 @@ class PriceSeries;
 class RSI : public IOverlay {
 private:
     int period;
-    std::map<std::time_t, double> data;
 
 public:
     RSI(std::shared_ptr<PriceSeries> priceSeries, int period = 14);
@@ -18,8 +17,6 @@ public:
     void checkArguments() override;
     void calculate() override;
     void plot() const override;
-    TimeSeries<std::vector<double>> getDataMap() const override;
-    std::vector<std::vector<std::string>> getTableData() const override;
 };
 
 #endif // RSI_HPP
\ No newline at end of file
@@ -10,7 +10,6 @@ class PriceSeries;
 class SMA : public IOverlay {
 private:
     int period;
-    TimeSeries<double> data;
 
 public:
     SMA(std::shared_ptr<PriceSeries> priceSeries, int period = 20);
@@ -18,10 +17,9 @@ public:
     void checkArguments() override;
     void calculate() override;
     void plot() const override;
-    TimeSeries<std::vector<double>> getDataMap() const override;
-    std::vector<std::vector<std::string>> getTableData() const override;
 
     const TimeSeries<double> getData() const;
+    const std::vector<double>& getValues() const;
 };
 
 #endif // SMA_HPP
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <datetime.h>
 
 #include <fstream>
+#include <functional>
 #include <string>
 #include <sstream>
 #include <thread>
@@ -14,6 +15,7 @@
 #include <memory>
 
 #include "types.hpp"
+#include "data_provider.hpp"
 #include "time_utils.hpp"
 #include "print_utils.hpp"
 #include "timeseries/timeseries_models.hpp"
@@ -34,7 +36,7 @@ private:
     std::time_t start;
     std::time_t end;
     std::string interval;
-    int count;
+    int count = 0;
 
     std::vector<std::time_t> dates;
     std::vector<double> opens;
@@ -49,10 +51,15 @@ private:
     bool includeMACD = false;
 
     // Private constructor
-    PriceSeries(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval);
+    PriceSeries(const DataProvider& provider, const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval);
 
     void checkArguments();
-    void fetchData();
+    void fetchData(const DataProvider& provider);
+    void setData(PriceData&& data);
+
+    // Table reading price columns and overlay columns in place, overlay
+    // values are blank outside the bars they cover
+    NumericTable getNumericTable(bool includeOverlays) const;
 
 public:
     PriceSeries();
@@ -61,20 +68,39 @@ public:
     // static PyObject* fetchData(PyObject* self, PyObject* args);
 
     void plot(const std::string& type = "line", const bool includeVolume = false, const std::string& savePath = "") const;
+    // Draw the price, volume, RSI and MACD panels on a 5 row grid, calling
+    // selectPanel(row, rowSpan) to make each panel's axes current first
+    void draw(const std::string& type, const bool includeVolume, const std::function<void(long, long)>& selectPanel) const;
     std::vector<std::vector<std::string>> getTableData() const;
     std::string toString(bool includeOverlays = false, bool changeHighlighting = true) const;
+    // Only the first or last rows are formatted
+    std::string getHead(std::size_t rows = 10, bool includeOverlays = false, bool changeHighlighting = true) const;
+    std::string getTail(std::size_t rows = 10, bool includeOverlays = false, bool changeHighlighting = true) const;
+    // Stream the whole table in chunks of rows
+    void print(std::ostream& out, bool includeOverlays = false, bool changeHighlighting = true) const;
 
     // Factory methods ---------------------------------------------------------
+    // Data comes from the provider set here, Yahoo Finance by default
+    static void setDataProvider(std::shared_ptr<DataProvider> provider);
+    static std::shared_ptr<DataProvider> getDataProvider();
+
+    static std::unique_ptr<PriceSeries> getPriceSeries(const DataProvider& provider, const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval = "1d");
     static std::unique_ptr<PriceSeries> getPriceSeries(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval);
     static std::unique_ptr<PriceSeries> getPriceSeries(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval);
     static std::unique_ptr<PriceSeries> getPriceSeries(const std::string& ticker, const std::time_t start, const std::time_t end);
     static std::unique_ptr<PriceSeries> getPriceSeries(const std::string& ticker, const std::string& start, const std::string& end);
     static std::unique_ptr<PriceSeries> getPriceSeries(const std::string& ticker, const std::time_t start, const std::string& interval, const std::size_t count);
     static std::unique_ptr<PriceSeries> getPriceSeries(const std::string& ticker, const std::string& start, const std::string& interval, const std::size_t count);
+    // Fetch many tickers, with one request when the provider supports it. When given, prepare (e.g.
+    // adding overlays) runs on up to threadCount workers for each series as
+    // soon as its data has been copied, while later tickers are still landing
+    static std::vector<std::unique_ptr<PriceSeries>> getPriceSeriesBatch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval = "1d", const std::function<void(PriceSeries&)>& prepare = nullptr, unsigned threadCount = 0);
+    static std::vector<std::unique_ptr<PriceSeries>> getPriceSeriesBatch(const std::vector<std::string>& tickers, const std::string& start, const std::string& end, const std::string& interval = "1d", const std::function<void(PriceSeries&)>& prepare = nullptr, unsigned threadCount = 0);
 
     // Getters -----------------------------------------------------------------
     int getCount() const;
     const std::string getTicker() const;
+    const std::string getInterval() const;
     const std::vector<std::time_t> getDates() const;
     const std::vector<double> getOpens() const;
     const std::vector<double> getHighs() const;
@@ -83,6 +109,13 @@ public:
     const std::vector<double> getAdjCloses() const;
     const std::vector<long> getVolumes() const;
 
+    // Resampling --------------------------------------------------------------
+    // Aggregate bars into the buckets of a coarser interval in one pass: first
+    // open, highest high, lowest low, last close and adjusted close, summed
+    // volume. Bars are dated by the start of their bucket and overlays are
+    // not carried over.
+    std::unique_ptr<PriceSeries> resample(const Interval& interval) const;
+
     // Overlays ----------------------------------------------------------------
     void addOverlay(const std::shared_ptr<IOverlay> overlay);
     const std::vector<std::shared_ptr<IOverlay>>& getOverlays() const;
@@ -103,6 +136,13 @@ public:
     const std::shared_ptr<AR> getAR(int arOrder) const;
     const std::shared_ptr<MA> getMA(int maOrder) const;
     const std::shared_ptr<ARMA> getARMA(int arOrder, int maOrder) const;
+    const std::shared_ptr<ARIMA> getARIMA(int arOrder, int diffOrder, int maOrder) const;
+    const std::shared_ptr<GARCH> getGARCH(int arOrder = 0, int maOrder = 0) const;
+    const std::shared_ptr<HoltWinters> getHoltWinters(int period = 0) const;
+
+    // Autocorrelations of the closes, or of their log returns
+    std::vector<double> getACF(int maxLag = 20, bool useReturns = false) const;
+    std::vector<double> getPACF(int maxLag = 20, bool useReturns = false) const;
 
     // Exports -----------------------------------------------------------------
     void exportCSV(const std::string& filename = "", const char delimiter = ',', const bool includeOverlays = true) const;
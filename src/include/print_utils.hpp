@@ -3,6 +3,10 @@
 #ifndef PRINT_UTILS_HPP
 #define PRINT_UTILS_HPP
 
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <map>
@@ -58,4 +62,68 @@ std::string getTable(const std::string& title,
                      const std::vector<std::string>& columnHeaders,
                      bool changeHighlighting);
 
+// Numeric tables --------------------------------------------------------------
+// A column of a NumericTable, reading either doubles or integers. Values
+// cover rows [first, first + count), other rows and NaN values print blank.
+struct TableColumn {
+    std::string header;
+    int width;
+    const double* values = nullptr;
+    const long* integers = nullptr;
+    int precision = 3;
+    std::size_t first = 0;
+    std::size_t count = static_cast<std::size_t>(-1);
+
+    bool hasRow(std::size_t row) const {
+        return row >= first && row - first < count;
+    }
+    double getValue(std::size_t row) const {
+        if (!hasRow(row)) {
+            return NAN;
+        }
+        return values ? values[row - first] : static_cast<double>(integers[row - first]);
+    }
+};
+
+// Table over numeric columns that are only formatted for the rows printed.
+// Change highlighting compares numbers directly and output is written into
+// one pre-sized buffer, or streamed in chunks. Columns are not copied, their
+// values must outlive the table.
+class NumericTable {
+private:
+    std::string title;
+    std::size_t rowCount;
+    std::string labelHeader;
+    int labelWidth = 0;
+    std::function<std::string(std::size_t)> label; // Text of the first column
+    std::vector<TableColumn> columns;
+
+    std::vector<int> getColumnWidths() const;
+    std::size_t getRowBytes() const;
+    void writeHeader(std::string& out) const;
+    void writeFooter(std::string& out) const;
+    void writeEllipsis(std::string& out) const;
+    // Rows [first, last), colored against the value before first
+    void writeRows(std::string& out, std::size_t first, std::size_t last, bool changeHighlighting) const;
+
+public:
+    NumericTable(const std::string& title, std::size_t rowCount);
+
+    // First column, left justified, with text built only for printed rows
+    void setLabels(const std::string& header, int width, std::function<std::string(std::size_t)> label);
+    void addColumn(const std::string& header, int width, const double* values, int precision = 3);
+    // Column whose values start at row first, blank outside count rows
+    void addColumn(const std::string& header, int width, const double* values, std::size_t first, std::size_t count, int precision = 3);
+    void addColumn(const std::string& header, int width, const long* values);
+
+    std::size_t size() const { return rowCount; }
+
+    // Every row, count rows from first, or the first head and last tail rows
+    // either side of an ellipsis row
+    std::string toString(bool changeHighlighting = false) const;
+    std::string getPage(std::size_t first, std::size_t count, bool changeHighlighting = false) const;
+    std::string getHeadTail(std::size_t head, std::size_t tail, bool changeHighlighting = false) const;
+    void write(std::ostream& out, bool changeHighlighting = false) const;
+};
+
 #endif // PRINT_UTILS_HPP
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef PYTHON_WORKER_HPP
+#define PYTHON_WORKER_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "priceseries.hpp"
+#include "render.hpp"
+
+// Runs every call into the embedded interpreter on one worker thread, so
+// compute threads can fetch and plot without touching interpreter state or
+// waiting on Python themselves. Requests are queued and answered through
+// futures; the worker takes the GIL once for every batch of requests waiting
+// when it wakes, and saves charts with the Agg backend.
+//
+// The constructing thread hands the interpreter to the worker through an
+// InterpreterRelease, shared with any render queues, until it is destroyed,
+// so it must not call into Python directly in the meantime and must be the
+// thread that destroys the worker.
+class PythonWorker {
+private:
+    InterpreterRelease release;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable ready; // Requests queued or stopping
+    std::vector<std::function<void()>> pending;
+    bool stopping = false;
+
+    void run();
+    void enqueue(std::function<void()> request);
+
+public:
+    PythonWorker();
+    // Answers every queued request before returning
+    ~PythonWorker();
+    PythonWorker(const PythonWorker&) = delete;
+    PythonWorker& operator=(const PythonWorker&) = delete;
+
+    // Run task() on the worker with the GIL held, any exception it throws is
+    // rethrown from the future's get()
+    template <typename Task>
+    std::future<std::invoke_result_t<Task>> submit(Task&& task) {
+        using Result = std::invoke_result_t<Task>;
+        auto request = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        std::future<Result> result = request->get_future();
+        enqueue([request] { (*request)(); });
+        return result;
+    }
+
+    std::future<std::unique_ptr<PriceSeries>> fetchAsync(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval = "1d");
+    std::future<std::unique_ptr<PriceSeries>> fetchAsync(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval = "1d");
+
+    // Charts are always saved, windows can't be shown from the worker thread
+    std::future<void> plotAsync(std::shared_ptr<const PriceSeries> series, const std::string& savePath, const std::string& type = "line", const bool includeVolume = false);
+};
+
+#endif // PYTHON_WORKER_HPP
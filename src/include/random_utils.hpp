@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef RANDOM_UTILS_HPP
+#define RANDOM_UTILS_HPP
+
+#include <cstdint>
+#include <limits>
+
+// xoshiro256** generator. Small and fast enough to give every thread or task
+// its own stream, and usable with the <random> distributions.
+class Xoshiro256 {
+private:
+    std::uint64_t state[4];
+
+    static std::uint64_t splitMix(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = std::uint64_t;
+
+    // Streams with the same seed but different stream ids are independent
+    explicit Xoshiro256(std::uint64_t seed = 0, std::uint64_t stream = 0) {
+        std::uint64_t x = seed ^ splitMix(stream);
+        for (auto& s : state) {
+            s = splitMix(x);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform double in [0, 1)
+    double uniform() {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+};
+
+#endif // RANDOM_UTILS_HPP
@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef RENDER_HPP
+#define RENDER_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "priceseries.hpp"
+
+// Switch pyplot to the Agg backend, the GIL must be held
+void useAggBackend();
+
+// Releases the GIL held by the calling thread while any instance is alive,
+// so worker threads can take it with PyGILState_Ensure. Instances share one
+// saved thread state: the first starts the interpreter and saves the state
+// of the thread holding the GIL, the last gives it back. Each instance must
+// be destroyed on the thread that created it, and the last one on the
+// thread whose state was saved, otherwise the program is terminated.
+class InterpreterRelease {
+private:
+    std::thread::id creator;
+
+public:
+    InterpreterRelease();
+    ~InterpreterRelease();
+    InterpreterRelease(const InterpreterRelease&) = delete;
+    InterpreterRelease& operator=(const InterpreterRelease&) = delete;
+};
+
+// How a queued chart is drawn, matching the arguments of PriceSeries::plot
+struct PlotSpec {
+    std::string type = "line";  // "line", "candlestick" or "area"
+    bool includeVolume = false;
+    std::size_t width = 1200;   // Figure size in pixels at 100 dpi
+    std::size_t height = 800;
+    int dpi = 300;              // Resolution of the saved image
+};
+
+struct RenderJob {
+    std::shared_ptr<const PriceSeries> series;
+    PlotSpec spec;
+    std::string path;
+};
+
+// Throw std::invalid_argument if a job can't be rendered
+void checkJob(const RenderJob& job);
+
+struct RenderStats {
+    std::size_t rendered = 0;
+    std::size_t failed = 0;
+    double seconds = 0.0;            // Time the worker spent rendering
+    std::vector<std::string> errors; // "path: message" for each failed job
+
+    double getChartsPerSecond() const;
+    std::string toString() const;
+};
+
+// Saves charts from a single worker thread with the Agg backend. The worker
+// keeps one figure and its axes between charts, clearing rather than
+// rebuilding them while the figure size and panel layout stay the same, and
+// takes the GIL once for every batch of jobs waiting when it wakes.
+//
+// The constructing thread hands the interpreter to the worker through an
+// InterpreterRelease until the queue is destroyed, so it must not plot
+// directly in the meantime and must be the thread that destroys the queue.
+// Queues and PythonWorkers share pyplot's current figure, so only one of
+// them should be drawing at a time.
+class RenderQueue {
+private:
+    // Axes of one panel of the figure's 5 row grid
+    struct Panel {
+        long row;
+        long rowSpan;
+        PyObject* axes;
+    };
+
+    InterpreterRelease release;
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable ready; // Jobs queued or stopping
+    std::condition_variable idle;  // Queue drained
+    std::vector<RenderJob> pending;
+    bool busy = false;
+    bool stopping = false;
+    RenderStats stats;
+
+    // Only touched by the worker, with the GIL held
+    PyObject* figure = nullptr;
+    std::size_t figureWidth = 0;
+    std::size_t figureHeight = 0;
+    std::vector<Panel> panels;
+
+    void run();
+    void render(const RenderJob& job);
+    void useFigure(const PlotSpec& spec);
+    void selectPanel(std::size_t index, long row, long rowSpan);
+    void dropPanels(std::size_t count);
+    void closeFigure();
+
+public:
+    RenderQueue();
+    // Renders every queued job before returning
+    ~RenderQueue();
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Queue a chart, arguments are checked here so bad jobs fail early
+    void submit(std::shared_ptr<const PriceSeries> series, const PlotSpec& spec, const std::string& path);
+    void submit(const std::vector<RenderJob>& jobs);
+
+    // Block until every queued job is done, returning totals so far
+    RenderStats wait();
+    RenderStats getStats() const;
+};
+
+#endif // RENDER_HPP
@@ -0,0 +1,136 @@
+#pragma once
+
+#ifndef THREAD_UTILS_HPP
+#define THREAD_UTILS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Resolve a requested worker count, 0 means use every available core
+inline unsigned getThreadCount(unsigned requested = 0) {
+    if (requested != 0) {
+        return requested;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Call body(i, worker) for every i in [0, count) across up to threadCount
+// workers. Indices are handed out dynamically so uneven tasks still balance,
+// and worker is always < getThreadCount(threadCount) so callers can keep
+// per-worker scratch state. The first exception thrown by body is rethrown.
+template <typename Body>
+void parallelFor(std::size_t count, unsigned threadCount, Body&& body) {
+    std::size_t workerCount = std::min<std::size_t>(getThreadCount(threadCount), count);
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto work = [&](unsigned worker) {
+        try {
+            for (std::size_t i = next++; i < count; i = next++) {
+                body(i, worker);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = count; // Stop handing out work
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned worker = 1; worker < workerCount; ++worker) {
+        threads.emplace_back(work, worker);
+    }
+    work(0); // Caller's thread acts as worker 0
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Call produce(emit) on the caller's thread, and consume(i, worker) on up to
+// threadCount workers for every index it passes to emit, so work on early
+// items overlaps producing later ones. Anything produce wrote for an item
+// before emitting it is visible to consume. The first exception thrown by
+// either side is rethrown once every worker has stopped.
+template <typename Produce, typename Consume>
+void pipeline(unsigned threadCount, Produce&& produce, Consume&& consume) {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::size_t> queue;
+    bool done = false;
+    std::exception_ptr error;
+
+    auto work = [&](unsigned worker) {
+        while (true) {
+            std::size_t i;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return done || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                i = queue.front();
+                queue.pop_front();
+                if (error) {
+                    continue; // Drain without working after a failure
+                }
+            }
+            try {
+                consume(i, worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned worker = 0; worker < getThreadCount(threadCount); ++worker) {
+        threads.emplace_back(work, worker);
+    }
+
+    auto emit = [&](std::size_t i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(i);
+        }
+        ready.notify_one();
+    };
+    try {
+        produce(emit);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    ready.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif // THREAD_UTILS_HPP
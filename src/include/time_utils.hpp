@@ -6,10 +6,14 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <cstdint>
 #include <ctime>
 #include <iomanip>
 #include <string>
+#include <string_view>
 #include <array>
+#include <stdexcept>
+#include <tuple>
 #include <algorithm>
 
 constexpr std::time_t MINUTE_DURATION = 60;
@@ -21,6 +25,140 @@ constexpr std::time_t YEAR_DURATION = DAY_DURATION * 365;
 
 constexpr std::array<std::string_view, 6> VALID_INTERVALS{"1m", "1h", "1d", "1wk", "1mo", "1y"};
 
+// Civil dates -----------------------------------------------------------------
+// Dates are read and written in local standard time, the clock mktime uses
+// for tm_isdst = 0, with the UTC offset looked up once per process. The
+// functions below are safe to call from any thread.
+struct CivilDate {
+    int year;
+    int month; // 1 to 12
+    int day;   // 1 to 31
+};
+
+// Days since 1970-01-01 of a proleptic Gregorian date, days past the end of
+// a month carry into the next as with mktime
+constexpr std::int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const std::int64_t yearOfEra = year - era * 400;
+    const std::int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+constexpr CivilDate civilFromDays(std::int64_t days) {
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const std::int64_t dayOfEra = days - era * 146097;
+    const std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const std::int64_t monthIndex = (5 * dayOfYear + 2) / 153; // From March
+    const int day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    const int month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    return {static_cast<int>(yearOfEra + era * 400 + (month <= 2)), month, day};
+}
+
+// Seconds local standard time is ahead of UTC
+std::time_t getUTCOffset();
+
+constexpr std::size_t DATE_LENGTH = 10;     // YYYY-MM-DD
+constexpr std::size_t DATETIME_LENGTH = 19; // YYYY-MM-DD HH:MM:SS
+
+// Format a column of dates back to back without terminators, count *
+// DATE_LENGTH chars, or count * DATETIME_LENGTH with the time. Years are
+// written as four digits, so dates must fall in years 0 to 9999.
+void formatDates(const std::time_t* dates, std::size_t count, char* out, bool includeTime = false);
+// Parse a column of YYYY-MM-DD dates. Dates that can not be parsed are set
+// to -1, returns how many there were.
+std::size_t parseDates(const std::string* dates, std::size_t count, std::time_t* out);
+// Turn wall clock seconds since 1970, as pandas gives for naive timestamps,
+// into epoch times. out may be wallClock.
+void wallClockToEpoch(const std::time_t* wallClock, std::size_t count, std::time_t* out);
+
+// Bar intervals ---------------------------------------------------------------
+// A bar length as a count of calendar units. Minute, hour and day buckets
+// are counted from the epoch in local standard time, weeks start on Monday
+// and months and years on their first day.
+class Interval {
+public:
+    enum class Unit {
+        MINUTE,
+        HOUR,
+        DAY,
+        WEEK,
+        MONTH,
+        YEAR
+    };
+
+private:
+    int count;
+    Unit unit;
+
+    std::time_t getBucketStart(std::time_t date, int bucketsAhead) const;
+
+public:
+    constexpr Interval(int count, Unit unit) : count(count), unit(unit) {
+        if (count < 1) {
+            throw std::invalid_argument("Could not create interval: count must be greater than 0");
+        }
+    }
+
+    // Parse a count and a unit of m, h, d, wk, mo or y, e.g. 15m or 1wk
+    static constexpr Interval fromString(std::string_view text) {
+        int count = 0;
+        std::size_t i = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            count = count * 10 + (text[i] - '0');
+        }
+        std::string_view suffix = text.substr(i);
+        if (i > 0 && count > 0) {
+            if (suffix == "m") return Interval(count, Unit::MINUTE);
+            if (suffix == "h") return Interval(count, Unit::HOUR);
+            if (suffix == "d") return Interval(count, Unit::DAY);
+            if (suffix == "wk") return Interval(count, Unit::WEEK);
+            if (suffix == "mo") return Interval(count, Unit::MONTH);
+            if (suffix == "y") return Interval(count, Unit::YEAR);
+        }
+        throw std::invalid_argument("Could not parse interval " + std::string(text));
+    }
+
+    constexpr int getCount() const { return count; }
+    constexpr Unit getUnit() const { return unit; }
+
+    // Nominal length, months are 30 days and years 365
+    constexpr std::time_t getSeconds() const {
+        switch (unit) {
+            case Unit::MINUTE: return count * MINUTE_DURATION;
+            case Unit::HOUR: return count * HOUR_DURATION;
+            case Unit::DAY: return count * DAY_DURATION;
+            case Unit::WEEK: return count * WEEK_DURATION;
+            case Unit::MONTH: return count * MONTH_DURATION;
+            case Unit::YEAR: return count * YEAR_DURATION;
+        }
+        return 0;
+    }
+
+    std::string toString() const;
+
+    // Start of the bucket holding date, and of the bucket after it
+    std::time_t getBucketStart(std::time_t date) const { return getBucketStart(date, 0); }
+    std::time_t getBucketEnd(std::time_t date) const { return getBucketStart(date, 1); }
+
+    constexpr bool operator==(const Interval& other) const { return count == other.count && unit == other.unit; }
+    constexpr bool operator!=(const Interval& other) const { return !(*this == other); }
+};
+
+constexpr Interval MINUTE_INTERVAL(1, Interval::Unit::MINUTE);
+constexpr Interval HOUR_INTERVAL(1, Interval::Unit::HOUR);
+constexpr Interval DAY_INTERVAL(1, Interval::Unit::DAY);
+constexpr Interval WEEK_INTERVAL(1, Interval::Unit::WEEK);
+constexpr Interval MONTH_INTERVAL(1, Interval::Unit::MONTH);
+constexpr Interval YEAR_INTERVAL(1, Interval::Unit::YEAR);
+
+// Median gap between consecutive dates in increasing order, robust to
+// weekends and holidays. One day when there are fewer than two dates.
+std::time_t getMedianSpacing(const std::time_t* dates, std::size_t count);
+
 std::time_t dateStringToEpoch(const std::string& dateStr);
 std::string epochToDateString(const std::time_t date, bool includeTime = false);
 std::time_t intervalToSeconds(const std::string& interval);
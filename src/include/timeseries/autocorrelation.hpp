@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef AUTOCORRELATION_HPP
+#define AUTOCORRELATION_HPP
+
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Scratch memory for FFT autocorrelations, reused between series. Not
+// thread-safe, each thread should own one.
+struct CorrelationWorkspace {
+    std::vector<std::complex<double>> buffer;
+    std::vector<std::complex<double>> twiddles; // exp(-2 pi i k / size) for k < size / 2
+};
+
+// In-place radix-2 FFT of a power of two sized buffer, inverse when requested
+// (unscaled)
+void fft(std::vector<std::complex<double>>& buffer, std::vector<std::complex<double>>& twiddles, bool inverse);
+
+// Sample autocorrelations r_0..r_maxLag of count values, computed in
+// O(n log n) from the power spectrum of the demeaned, zero padded series.
+// Lags of a constant series are 0.
+void getACF(const double* values, std::size_t count, int maxLag, double* out, CorrelationWorkspace& workspace);
+std::vector<double> getACF(const std::vector<double>& values, int maxLag);
+
+// Partial autocorrelations from autocorrelations r_0..r_maxLag by the
+// Durbin-Levinson recursion in O(maxLag^2), out[0] is 1
+void getPACF(const double* acf, int maxLag, double* out);
+std::vector<double> getPACF(const std::vector<double>& acf);
+
+// Autocorrelations and partial autocorrelations of many series, stored
+// row-major with maxLag + 1 values per series
+struct CorrelationTable {
+    int maxLag;
+    std::vector<std::size_t> counts; // Values in each series
+    std::vector<double> acf;
+    std::vector<double> pacf;
+
+    std::size_t size() const { return counts.size(); }
+    const double* getACF(std::size_t series) const { return acf.data() + series * (maxLag + 1); }
+    const double* getPACF(std::size_t series) const { return pacf.data() + series * (maxLag + 1); }
+
+    // Half width of the approximate white noise confidence band, z / sqrt(n)
+    double getBound(std::size_t series, double level = 0.95) const;
+
+    std::string toString(std::size_t series = 0) const;
+};
+
+// Correlations of every series, computed in parallel with one workspace per
+// thread, threadCount 0 uses every core
+CorrelationTable getCorrelations(const std::vector<std::vector<double>>& series, int maxLag, unsigned threadCount = 0);
+
+#endif // AUTOCORRELATION_HPP
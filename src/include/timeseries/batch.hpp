@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../types.hpp"
+#include "fitting.hpp"
+
+// Number of AR and MA terms a model type actually uses
+std::pair<int, int> getModelOrders(ModelType type, int arOrder, int maOrder);
+
+// Short name of a model type and its orders, e.g. ARMA(2, 1)
+std::string getModelName(ModelType type, int arOrder, int maOrder);
+
+// Parameters and metrics of one model type fitted to many series. Parameters
+// are stored row-major with one row of paramCount values per series, laid out
+// as [c, phi_1, ..., phi_p, theta_1, ..., theta_q].
+struct BatchFitTable {
+    ModelType type;
+    int arOrder;
+    int maOrder;
+    std::size_t paramCount;
+
+    std::vector<double> params;
+    std::vector<double> nll;
+    std::vector<double> mse;
+    std::vector<double> rmse;
+    std::vector<double> mae;
+
+    std::size_t size() const { return nll.size(); }
+    const double* getParams(std::size_t series) const { return params.data() + series * paramCount; }
+    double getC(std::size_t series) const { return getParams(series)[0]; }
+    double getPhi(std::size_t series, int lag) const { return getParams(series)[lag]; }
+    double getTheta(std::size_t series, int lag) const { return getParams(series)[arOrder + lag]; }
+
+    std::string toString() const;
+};
+
+// Fit the same model to every series in values, where series i occupies
+// values[offsets[i], offsets[i+1]). Series are fitted in parallel with one
+// reusable FitWorkspace per thread, threadCount 0 uses every core. Orders not
+// used by the model type are ignored, e.g. MA models only read maOrder.
+BatchFitTable fitBatch(const std::vector<double>& values,
+                       const std::vector<std::size_t>& offsets,
+                       ModelType type,
+                       int arOrder,
+                       int maOrder = 0,
+                       unsigned threadCount = 0);
+BatchFitTable fitBatch(const std::vector<std::vector<double>>& series,
+                       ModelType type,
+                       int arOrder,
+                       int maOrder = 0,
+                       unsigned threadCount = 0);
+
+#endif // BATCH_HPP
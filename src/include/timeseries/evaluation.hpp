@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef EVALUATION_HPP
+#define EVALUATION_HPP
+
+#include <string>
+#include <vector>
+
+#include "../types.hpp"
+#include "fitting.hpp"
+
+struct WalkForwardConfig {
+    std::size_t initialWindow;   // Training observations before the first origin
+    int horizon = 1;             // Steps forecast from each origin
+    int refitEvery = 1;          // Refit every k origins, in between parameters are reused
+    std::size_t step = 1;        // Observations between consecutive origins
+    bool expanding = true;       // Expanding window, otherwise a rolling window of initialWindow
+    unsigned threadCount = 0;    // 0 uses every core
+};
+
+// Out-of-sample accuracy of a rolling-origin evaluation. Index h of the
+// metric vectors holds the (h+1)-step ahead results.
+struct WalkForwardResult {
+    std::vector<double> rmse;
+    std::vector<double> mae;
+    std::vector<std::size_t> counts;   // Forecasts scored per horizon
+    std::vector<std::size_t> origins;  // Index of the first forecast value at each origin
+    std::vector<double> forecasts;     // Row-major origins x horizon
+    std::size_t refits = 0;
+
+    std::string toString() const;
+};
+
+// Walk forward through values, forecasting horizon steps from every origin.
+// Origins are split into contiguous blocks evaluated in parallel, within a
+// block each refit is warm-started from the previous parameters.
+WalkForwardResult walkForward(const std::vector<double>& values,
+                              ModelType type,
+                              int arOrder,
+                              int maOrder,
+                              const WalkForwardConfig& config);
+
+#endif // EVALUATION_HPP
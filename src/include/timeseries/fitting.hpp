@@ -0,0 +1,192 @@
+#pragma once
+
+#ifndef FITTING_HPP
+#define FITTING_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <nlopt.hpp>
+#include "../types.hpp"
+#include "../../third_party/Eigen/Dense"
+
+// Non-owning view of a contiguous series passed to the likelihood objectives
+struct SeriesView {
+    const double* data;
+    std::size_t count;
+    int p; // AR order
+    int q; // MA order
+};
+
+// Parameters and in-sample metrics of a single fitted model
+struct ModelFit {
+    double c = 0.0;
+    std::vector<double> phis;   // AR coefficients
+    std::vector<double> thetas; // MA coefficients
+
+    double nll = 0.0;
+    double mse = 0.0;
+    double rmse = 0.0;
+    double mae = 0.0;
+
+    // Write parameters as [c, phi_1, ..., phi_p, theta_1, ..., theta_q]
+    void getParams(std::vector<double>& params) const {
+        params.clear();
+        params.push_back(c);
+        params.insert(params.end(), phis.begin(), phis.end());
+        params.insert(params.end(), thetas.begin(), thetas.end());
+    }
+};
+
+// Optimizer state and scratch memory reused between fits and between
+// likelihood evaluations. Workspaces are not thread-safe, each thread fitting
+// models should own one.
+struct FitWorkspace {
+    nlopt::opt optimizer;
+    unsigned dimension = 0;
+    std::vector<double> x;         // Parameter vector handed to the optimizer
+    std::vector<double> residuals; // Residuals of the latest likelihood evaluation
+    std::vector<double> arLags;    // AR coefficients reversed to line up with data windows
+    std::vector<double> maLags;    // MA coefficients reversed to line up with residual windows
+
+    // Get optimizer for a problem of the given size, only rebuilt when the
+    // size changes
+    nlopt::opt& getOptimizer(unsigned dimension, double xtolRel, int maxEval) {
+        if (this->dimension != dimension) {
+            optimizer = nlopt::opt(nlopt::LN_COBYLA, dimension);
+            this->dimension = dimension;
+        }
+        optimizer.set_xtol_rel(xtolRel);
+        optimizer.set_maxeval(maxEval);
+        return optimizer;
+    }
+
+    // Size buffers for a series so likelihood evaluations never allocate
+    void reserve(std::size_t count, int p, int q) {
+        residuals.assign(count, 0.0);
+        arLags.assign(p, 0.0);
+        maLags.assign(q, 0.0);
+    }
+};
+
+// Data handed to the NLopt objective wrappers
+struct ObjectiveData {
+    SeriesView series;
+    FitWorkspace* workspace;
+};
+
+// Negative log-likelihood of params = [c, phi_1..phi_p, theta_1..theta_q] on
+// a series. Residuals are written into workspace.residuals, which must have
+// been reserved for the series beforehand.
+double getNLLAR(const double* params, const SeriesView& series, FitWorkspace& workspace);
+double getNLLMA(const double* params, const SeriesView& series, FitWorkspace& workspace);
+double getNLLARMA(const double* params, const SeriesView& series, FitWorkspace& workspace);
+
+// Parameters of an ARMA mean equation with GARCH(1,1) errors
+struct GARCHFit {
+    ModelFit mean;      // Mean equation, metrics are of its residuals
+    double omega = 0.0; // Variance constant
+    double alpha = 0.0; // ARCH coefficient on the last squared shock
+    double beta = 0.0;  // GARCH coefficient on the last variance
+};
+
+// Scratch memory for GARCH likelihood evaluations, see FitWorkspace
+struct GARCHWorkspace {
+    nlopt::opt optimizer;
+    unsigned dimension = 0;
+    std::vector<double> x;
+    std::vector<double> residuals;      // Mean equation shocks
+    std::vector<double> variances;      // Conditional variances
+    std::vector<double> residualGrads;  // count x meanParams derivatives of the shocks
+    std::vector<double> varianceGrads;  // Derivatives of the latest variance
+    std::vector<double> arLags;
+    std::vector<double> maLags;
+    double backcast = 0.0;              // Variance used before the first shock
+
+    // Gradient based optimizer with the variance parameter constraints, only
+    // rebuilt when the size changes
+    nlopt::opt& getOptimizer(unsigned dimension, double xtolRel, int maxEval);
+
+    void reserve(std::size_t count, int p, int q) {
+        std::size_t paramCount = 1 + p + q + 3;
+        residuals.assign(count, 0.0);
+        variances.assign(count, 0.0);
+        residualGrads.assign(count * (1 + p + q), 0.0);
+        varianceGrads.assign(paramCount, 0.0);
+        arLags.assign(p, 0.0);
+        maLags.assign(q, 0.0);
+    }
+};
+
+// GARCH objective data, see ObjectiveData
+struct GARCHObjectiveData {
+    SeriesView series;
+    GARCHWorkspace* workspace;
+};
+
+// Gaussian negative log-likelihood of params = [c, phi_1..phi_p,
+// theta_1..theta_q, omega, alpha, beta]. The shock and variance recursions
+// run in a single pass, and when grad is not null the analytic gradient is
+// written into it.
+double getNLLGARCH(const double* params, const SeriesView& series, GARCHWorkspace& workspace, double* grad);
+
+// Jointly fit an ARMA(arOrder, maOrder) mean and GARCH(1,1) variance
+GARCHFit fitGARCH(const double* data, std::size_t count, int arOrder, int maOrder, GARCHWorkspace& workspace, const GARCHFit* warmStart = nullptr);
+
+// Smoothing parameters and final states of an additive Holt-Winters model
+struct HoltWintersFit {
+    int period = 0;                // Season length, 0 without a seasonal component
+    double alpha = 0.0;            // Level smoothing
+    double beta = 0.0;             // Trend smoothing
+    double gamma = 0.0;            // Seasonal smoothing
+    double level = 0.0;            // States after the last observation
+    double trend = 0.0;
+    std::vector<double> seasonals; // seasonals[i] applies i + 1 steps ahead
+
+    double sse = 0.0;
+    double mse = 0.0;
+    double rmse = 0.0;
+    double mae = 0.0;
+};
+
+// Index of the first one-step error, earlier values initialise the states
+inline std::size_t getHoltWintersStart(int period) {
+    return period > 0 ? period : 2;
+}
+
+// Sum of squared one-step errors of params = [alpha, beta, gamma] on a
+// series, with the states, smoothing and metrics updated in a single pass.
+// States start from the first two seasons (or values without a season).
+// Final states and metrics are written into fit, whose period must be set,
+// and the errors into residuals when not null.
+double getSSEHoltWinters(const double* data, std::size_t count, const double* params, HoltWintersFit& fit, double* residuals = nullptr);
+
+// Fit the smoothing parameters by a coarse grid evaluated in parallel, then
+// refine the best grid point locally. threadCount 0 uses every core.
+HoltWintersFit fitHoltWinters(const double* data, std::size_t count, int period, unsigned threadCount = 0);
+
+// Dot product of n lag coefficients with a contiguous window of past values
+inline double lagDot(const double* coeffs, const double* window, int n) {
+    if (n == 0) {
+        return 0.0;
+    }
+    return Eigen::Map<const Eigen::VectorXd>(coeffs, n).dot(Eigen::Map<const Eigen::VectorXd>(window, n));
+}
+
+// Fit models to count contiguous values starting at data. When warmStart is
+// given the optimizer starts from its parameters instead of the defaults.
+// On return workspace.residuals holds the in-sample residuals of the fit.
+ModelFit fitAR(const double* data, std::size_t count, int arOrder, FitWorkspace& workspace, const ModelFit* warmStart = nullptr);
+ModelFit fitMA(const double* data, std::size_t count, int maOrder, FitWorkspace& workspace, const ModelFit* warmStart = nullptr);
+ModelFit fitARMA(const double* data, std::size_t count, int arOrder, int maOrder, FitWorkspace& workspace, const ModelFit* warmStart = nullptr);
+ModelFit fitModel(ModelType type, const double* data, std::size_t count, int arOrder, int maOrder, FitWorkspace& workspace, const ModelFit* warmStart = nullptr);
+
+// Recompute workspace.residuals for fixed fitted parameters on a series
+void computeResiduals(ModelType type, const ModelFit& fit, const SeriesView& series, FitWorkspace& workspace);
+
+// Point forecasts for the steps after the last of count values, with future
+// shocks at their zero mean. residuals are the in-sample residuals aligned
+// with data, out must hold steps values.
+void forecastFit(const ModelFit& fit, const double* data, const double* residuals, std::size_t count, int steps, double* out);
+
+#endif // FITTING_HPP
@@ -0,0 +1,120 @@
+#pragma once
+
+#ifndef FORECASTING_HPP
+#define FORECASTING_HPP
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "fitting.hpp"
+
+// Fixed-size window of the latest values of a series. Every value is written
+// twice, capacity apart, so the window is always contiguous oldest first and
+// lines up with reversed lag coefficients.
+class LagBuffer {
+private:
+    std::vector<double> buffer;
+    std::size_t capacity = 0;
+    std::size_t position = 0; // Slot of the newest value
+
+public:
+    LagBuffer() = default;
+
+    // Fill with the last capacity values of data, zero padded when data is
+    // shorter
+    void reset(const double* data, std::size_t count, std::size_t capacity);
+
+    void push(double value) {
+        if (capacity == 0) {
+            return;
+        }
+        position = position + 1 == capacity ? 0 : position + 1;
+        buffer[position] = value;
+        buffer[position + capacity] = value;
+    }
+
+    // Latest capacity values, oldest first
+    const double* window() const {
+        return capacity == 0 ? buffer.data() : buffer.data() + position + 1;
+    }
+
+    // Value lag steps back, lag 1 is the newest
+    double getLag(std::size_t lag) const {
+        return window()[capacity - lag];
+    }
+
+    std::size_t size() const { return capacity; }
+};
+
+// Point forecasts and prediction intervals at a set of horizons, h = 1 is the
+// step after the last observation
+struct ForecastResult {
+    std::vector<int> horizons;
+    std::vector<double> mean;   // Conditional mean
+    std::vector<double> stdErr; // Standard deviation of the forecast error
+    std::vector<double> lower;  // Lower bound of the prediction interval
+    std::vector<double> upper;  // Upper bound of the prediction interval
+    double level = 0.95;        // Coverage of the intervals
+
+    std::size_t size() const { return horizons.size(); }
+    std::string toString() const;
+};
+
+// Write psi_0..psi_{count-1} of the MA(infinity) expansion of an ARMA model,
+// psi_0 = 1 and psi_j = theta_j + phi_1 * psi_{j-1} + ... + phi_p * psi_{j-p}
+void getPsiWeights(const std::vector<double>& phis, const std::vector<double>& thetas, int count, double* out);
+
+// Difference count values in place d times, leaving the differenced series
+// at data + d. tails receives the last value of each difference before it is
+// differenced again, the original series first.
+void differenceInPlace(double* data, std::size_t count, int d, double* tails);
+
+// Undo differenceInPlace on count values continuing a series with the given
+// tails, in place. The tails are not modified.
+void integrateInPlace(double* values, std::size_t count, int d, const double* tails);
+
+// Inverse of the standard normal CDF
+double getNormalQuantile(double probability);
+
+// Coefficients and final lag state of a trained ARMA-type mean equation. Holds
+// O(p + q) values so forecasts cost O(steps * order) without the training
+// data.
+struct ForecastState {
+    bool ready = false;
+    double c = 0.0;
+    std::vector<double> arLags;  // AR coefficients reversed to line up with windows
+    std::vector<double> maLags;  // MA coefficients reversed to line up with windows
+    LagBuffer values;            // Last p observations
+    LagBuffer residuals;         // Last q residuals
+    std::time_t lastDate = 0;    // Date of the last observation
+
+    // Take coefficients from fit and the final lags from the last count
+    // values and residuals
+    void reset(const ModelFit& fit, const double* data, const double* residuals, std::size_t count, std::time_t lastDate);
+    void reset(const ModelFit& fit, const double* values, std::size_t valueCount, const double* residuals, std::size_t residualCount, std::time_t lastDate);
+
+    // Replace the coefficients keeping the lags, for online updates
+    void setCoefficients(double c, const std::vector<double>& phis, const std::vector<double>& thetas);
+
+    // Append a new observation and its residual
+    void push(std::time_t date, double value, double residual) {
+        values.push(value);
+        residuals.push(residual);
+        lastDate = date;
+    }
+
+    // Write conditional mean forecasts of the next steps into out, future
+    // shocks are taken as zero
+    void forecast(int steps, double* out) const;
+
+    // Forecasts at arbitrary horizons in any order. Means jump between sorted
+    // horizons with powers of the companion matrix once the MA terms have
+    // died out, and error variances are sigma^2 times running sums of squared
+    // psi-weights, so the cost grows linearly with the largest horizon
+    // and memory with the number of horizons.
+    ForecastResult forecast(const std::vector<int>& horizons, double sigma, double level = 0.95) const;
+};
+
+#endif // FORECASTING_HPP
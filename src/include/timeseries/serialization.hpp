@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../types.hpp"
+#include "fitting.hpp"
+
+class TimeSeriesModel;
+
+// Versioned binary format for trained AR/MA/ARMA models. Fields are native
+// endian and every record starts 8-byte aligned:
+//   header  char magic[4], uint32 version, uint64 record count
+//   record  uint32 type, int32 AR order, int32 MA order, uint32 reserved,
+//           int64 last date, double c, nll, mse, rmse, mae,
+//           phis, thetas, last p values and last q residuals oldest first
+constexpr char MODEL_FILE_MAGIC[4] = {'C', 'P', 'F', 'M'};
+constexpr std::uint32_t MODEL_FILE_VERSION = 1;
+
+// Everything a trained model needs to forecast without its training data
+struct ModelRecord {
+    ModelType type = ModelType::AR;
+    ModelFit fit;
+    std::vector<double> values;    // Last p observations, oldest first
+    std::vector<double> residuals; // Last q residuals, oldest first
+    std::time_t lastDate = 0;      // Date of the last observation
+
+    std::size_t getByteSize() const;
+};
+
+// Write records, or read every record of a stream written by writeModels
+void writeModels(std::ostream& out, const std::vector<ModelRecord>& records);
+std::vector<ModelRecord> readModels(std::istream& in);
+
+// Save trained models to a file, or load every model from one
+void saveModels(const std::string& path, const std::vector<std::shared_ptr<TimeSeriesModel>>& models);
+std::vector<std::shared_ptr<TimeSeriesModel>> loadModels(const std::string& path);
+
+// Construct the AR, MA or ARMA model a record describes
+std::shared_ptr<TimeSeriesModel> makeModel(const ModelRecord& record);
+
+// Read-only memory map of a model file. Opening only walks the record headers
+// to index them, records are decoded on access.
+class ModelStore {
+private:
+    const char* mapped = nullptr;
+    std::size_t mappedSize = 0;
+    std::vector<std::size_t> offsets; // Byte offset of each record
+
+public:
+    explicit ModelStore(const std::string& path);
+    ~ModelStore();
+
+    ModelStore(const ModelStore&) = delete;
+    ModelStore& operator=(const ModelStore&) = delete;
+
+    std::size_t size() const { return offsets.size(); }
+    ModelRecord getRecord(std::size_t i) const;
+    std::shared_ptr<TimeSeriesModel> getModel(std::size_t i) const;
+    std::vector<std::shared_ptr<TimeSeriesModel>> getModels() const;
+};
+
+#endif // SERIALIZATION_HPP
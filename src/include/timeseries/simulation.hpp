@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../types.hpp"
+#include "../../third_party/Eigen/Dense"
+#include "fitting.hpp"
+
+struct SimulationConfig {
+    int paths = 1000;
+    InnovationType innovations = InnovationType::GAUSSIAN;
+    std::vector<double> quantiles = {0.05, 0.5, 0.95};
+    bool keepPaths = true;     // Otherwise only mean and quantile bands are kept
+    std::uint64_t seed = 0;
+    unsigned threadCount = 0;  // 0 uses every core
+};
+
+struct SimulationResult {
+    Eigen::MatrixXd paths;          // steps x paths, each path contiguous. Empty unless keepPaths
+    std::vector<double> mean;       // Mean across paths per step
+    std::vector<double> quantiles;  // Quantile levels of the band columns
+    Eigen::MatrixXd bands;          // steps x quantiles
+};
+
+// Linearly interpolated quantile of values, reorders values
+double getQuantile(std::vector<double>& values, double level);
+
+// Simulate forecast paths for the steps after the last of count values.
+// Shocks are Gaussian with the fit's RMSE as scale, or drawn from the
+// in-sample residuals (aligned with data) after the first full lag window.
+// Paths are simulated in fixed blocks each with its own generator, so results
+// depend on the seed but not on the thread count. When data is a d times
+// differenced series, passing the d tails from differenceInPlace integrates
+// the paths back to levels.
+SimulationResult simulatePaths(const ModelFit& fit,
+                               const double* data,
+                               const double* residuals,
+                               std::size_t count,
+                               int steps,
+                               const SimulationConfig& config,
+                               const std::vector<double>& tails = {});
+
+// Simulate paths of an additive Holt-Winters model through its level, trend
+// and seasonal recursion from the final states of fit. Residuals are aligned
+// with the count training values and bootstrapped after the states' warm up.
+SimulationResult simulateHoltWinters(const HoltWintersFit& fit,
+                                     const double* residuals,
+                                     std::size_t count,
+                                     int steps,
+                                     const SimulationConfig& config);
+
+#endif // SIMULATION_HPP
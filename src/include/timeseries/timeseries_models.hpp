@@ -6,6 +6,12 @@
 #include "../types.hpp"
 #include "../time_utils.hpp"
 #include "../print_utils.hpp"
+#include "../decimation.hpp"
+#include "fitting.hpp"
+#include "forecasting.hpp"
+#include "serialization.hpp"
+#include "autocorrelation.hpp"
+#include "simulation.hpp"
 
 #include <vector>
 #include <iostream>
@@ -26,22 +32,87 @@ protected:
 
     std::string name;
     TimeSeries<double> data;
-    TimeSeries<double> forecasted;
+    std::vector<double> forecasted; // Latest forecasts, one per day after the last observation
     size_t count;
+    std::vector<double> residuals; // In-sample residuals, aligned with data
+    ForecastState state;           // Coefficients and final lags cached by train
+
+    // Restore the constant, metrics and lag state of a saved model, which
+    // keeps no training history
+    void restore(const ModelRecord& record);
+    ModelRecord makeRecord(ModelType type) const;
+
+    // Index of the first residual with a full lag window
+    virtual std::size_t getResidualStart() const {
+        return std::max(this->state.arLags.size(), this->state.maLags.size());
+    }
 
 public:
     TimeSeriesModel() = default;
     virtual ~TimeSeriesModel() = default;
 
-    virtual void forecast(int steps) = 0;
+    // Forecast the next steps from the cached lag state, O(steps * order)
+    void forecast(int steps) {
+        this->forecasted.resize(steps);
+        forecast(steps, this->forecasted.data());
+    }
+    virtual void forecast(int steps, double* out) const {
+        this->state.forecast(steps, out);
+    }
     // virtual TimeSeries<double> forecast(std::time_t start) = 0; // TODO: Forecast until requested time
 
+    // Forecasts with analytic prediction intervals at the given horizons, or
+    // at every step up to steps, with shocks scaled by the in-sample RMSE
+    virtual ForecastResult forecastIntervals(const std::vector<int>& horizons, double level = 0.95) const {
+        return this->state.forecast(horizons, this->rmse, level);
+    }
+    ForecastResult forecastIntervals(int steps, double level = 0.95) const {
+        std::vector<int> horizons(steps);
+        std::iota(horizons.begin(), horizons.end(), 1);
+        return forecastIntervals(horizons, level);
+    }
+
+    // Latest forecasts keyed by date
     TimeSeries<double> getForecasted() const {
+        TimeSeries<double> dated;
+        std::time_t date = this->state.lastDate;
+        for (double value : this->forecasted) {
+            date += DAY_INTERVAL.getSeconds();
+            dated.emplace_hint(dated.end(), date, value);
+        }
+        return dated;
+    }
+    const std::vector<double>& getForecasts() const {
         return forecasted;
     }
 
+    // Parameters and metrics of the trained model
+    virtual ModelFit getFit() const = 0;
+
+    // Simulate forecast paths with sampled future shocks
+    virtual SimulationResult simulate(int steps, const SimulationConfig& config = SimulationConfig()) const;
+
+    // ACF and PACF of the in-sample residuals after the first full lag
+    // window, close to zero at every lag when the orders are adequate
+    std::vector<double> getResidualACF(int maxLag = 20) const;
+    std::vector<double> getResidualPACF(int maxLag = 20) const;
+
+    // Persistence -------------------------------------------------------------
+    // Coefficients, metrics and final lag state, see serialization.hpp
+    virtual ModelRecord getRecord() const;
+    void save(const std::string& path) const;
+    static std::shared_ptr<TimeSeriesModel> load(const std::string& path);
+
+    double getC() const { return c; }
+    double getMSE() const { return mse; }
+    double getRMSE() const { return rmse; }
+    double getMAE() const { return mae; }
+
     int plot() const {
         namespace plt = matplotlibcpp;
+        if (data.empty()) {
+            throw std::runtime_error("Could not plot model: restored models have no history to plot");
+        }
 
         std::vector<std::time_t> dataXs;
         std::vector<double> dataYs;
@@ -49,12 +120,13 @@ public:
             dataXs.push_back(date);
             dataYs.push_back(value);
         }
+        decimateLTTB(dataXs, dataYs);
 
         std::vector<std::time_t> forecastedXs;
         forecastedXs.push_back(data.rbegin()->first);
         std::vector<double> forecastedYs;
         forecastedYs.push_back(data.rbegin()->second);
-        for (const auto& [date, value] : forecasted) {
+        for (const auto& [date, value] : getForecasted()) {
             forecastedXs.push_back(date);
             forecastedYs.push_back(value);
         }
@@ -87,11 +159,31 @@ private:
     int arOrder;
     std::vector<double> phis; // AR coefficients
 
+    // Recursive least squares state for online updating
+    bool online = false;
+    double forgettingFactor = 1.0;
+    Eigen::VectorXd rlsParams;       // [c, phi_1, ..., phi_p]
+    Eigen::MatrixXd rlsCovariance;   // Inverse of the weighted regressor Gram matrix
+    std::size_t errorCount = 0;      // One-step errors included in the running metrics
+    std::size_t historyWindow = 0;   // Latest observations kept in data and residuals by updates
+
+    Eigen::VectorXd getRegressor() const;
+
 public:
     AR(const TimeSeries<double>& data);
+    AR(const ModelRecord& record);
 
+    ModelFit getFit() const override;
+    ModelRecord getRecord() const override;
     void train(int arOrder);
-    void forecast(int steps) override;
+
+    // Online updating ---------------------------------------------------------
+    // Updates cost O(p^2) and keep between one and two times the training
+    // length of history for plots, residual checks and simulation
+    void enableOnline(double forgettingFactor = 1.0);
+    void update(std::time_t date, double value);
+    double getOneStepForecast() const;
+    bool isOnline() const;
 
     std::vector<double> getPhis() const;
 
@@ -105,9 +197,11 @@ private:
 
 public:
     MA(const TimeSeries<double>& data);
+    MA(const ModelRecord& record);
 
+    ModelFit getFit() const override;
+    ModelRecord getRecord() const override;
     void train(int maOrder);
-    void forecast(int steps) override;
 
     std::vector<double> getThetas() const;
 
@@ -123,9 +217,11 @@ private:
 
 public:
     ARMA(const TimeSeries<double>& data);
+    ARMA(const ModelRecord& record);
 
+    ModelFit getFit() const override;
+    ModelRecord getRecord() const override;
     void train(int arOrder, int maOrder);
-    void forecast(int steps) override;
 
     std::vector<double> getPhis() const;
     std::vector<double> getThetas() const;
@@ -133,4 +229,110 @@ public:
     std::string toString() const override;
 };
 
+// ARMA(p, q) mean with GARCH(1, 1) conditional variance, an order (0, 0) mean
+// is a constant
+class GARCH : public TimeSeriesModel {
+private:
+    int arOrder;
+    int maOrder;
+    std::vector<double> phis;      // AR coefficients
+    std::vector<double> thetas;    // MA coefficients
+    double omega;                  // Variance constant
+    double alpha;                  // ARCH coefficient
+    double beta;                   // GARCH coefficient
+    double nll;
+    std::vector<double> variances; // In-sample conditional variances, aligned with data
+
+public:
+    GARCH(const TimeSeries<double>& data);
+
+    ModelFit getFit() const override;
+    GARCHFit getGARCHFit() const;
+    void train(int arOrder = 0, int maOrder = 0);
+    std::vector<double> forecastVariance(int steps) const;
+
+    // Intervals scaled by the conditional variance path rather than the
+    // in-sample RMSE, widening after volatile bars and settling towards the
+    // long-run variance
+    using TimeSeriesModel::forecastIntervals;
+    ForecastResult forecastIntervals(const std::vector<int>& horizons, double level = 0.95) const override;
+
+    std::vector<double> getPhis() const;
+    std::vector<double> getThetas() const;
+    double getOmega() const;
+    double getAlpha() const;
+    double getBeta() const;
+    double getNLL() const;
+    std::vector<double> getVariances() const;
+
+    std::string toString() const override;
+};
+
+// ARMA(p, q) on the d times differenced series, with forecasts integrated
+// back to levels
+class ARIMA : public TimeSeriesModel {
+private:
+    int arOrder;
+    int diffOrder;
+    int maOrder;
+    std::vector<double> phis;        // AR coefficients
+    std::vector<double> thetas;      // MA coefficients
+    std::vector<double> differenced; // Training values differenced in place, series starts at diffOrder
+    std::vector<double> tails;       // Last value of each difference, levels first
+
+protected:
+    std::size_t getResidualStart() const override;
+
+public:
+    ARIMA(const TimeSeries<double>& data);
+
+    ModelFit getFit() const override;
+    void train(int arOrder, int diffOrder, int maOrder);
+
+    using TimeSeriesModel::forecast;
+    using TimeSeriesModel::forecastIntervals;
+    void forecast(int steps, double* out) const override;
+    ForecastResult forecastIntervals(const std::vector<int>& horizons, double level = 0.95) const override;
+    SimulationResult simulate(int steps, const SimulationConfig& config = SimulationConfig()) const override;
+
+    std::vector<double> getPhis() const;
+    std::vector<double> getThetas() const;
+    int getDiffOrder() const;
+
+    std::string toString() const override;
+};
+
+// Additive Holt-Winters exponential smoothing of level, trend and a season of
+// the given period, period 0 is Holt's linear trend
+class HoltWinters : public TimeSeriesModel {
+private:
+    HoltWintersFit fit;
+
+protected:
+    std::size_t getResidualStart() const override;
+
+public:
+    HoltWinters(const TimeSeries<double>& data);
+
+    ModelFit getFit() const override;
+    HoltWintersFit getHoltWintersFit() const;
+    void train(int period = 0, unsigned threadCount = 0);
+
+    using TimeSeriesModel::forecast;
+    using TimeSeriesModel::forecastIntervals;
+    void forecast(int steps, double* out) const override;
+    ForecastResult forecastIntervals(const std::vector<int>& horizons, double level = 0.95) const override;
+    SimulationResult simulate(int steps, const SimulationConfig& config = SimulationConfig()) const override;
+
+    int getPeriod() const;
+    double getAlpha() const;
+    double getBeta() const;
+    double getGamma() const;
+    double getLevel() const;
+    double getTrend() const;
+    std::vector<double> getSeasonals() const;
+
+    std::string toString() const override;
+};
+
 #endif // TIMESERIES_MODELS_HPP
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef VALIDATION_HPP
+#define VALIDATION_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../types.hpp"
+#include "fitting.hpp"
+
+struct CrossValidationConfig {
+    int folds = 5;             // Test blocks, the series is cut into folds + 1 blocks
+    std::size_t gap = 0;       // Observations left out between training and test data
+    unsigned threadCount = 0;  // 0 uses every core
+};
+
+// Out-of-sample one-step accuracy of blocked cross-validation, one row per
+// fold with its parameters stored row-major as [c, phi.., theta..]
+struct CrossValidationResult {
+    ModelType type;
+    int arOrder;
+    int maOrder;
+    std::size_t paramCount;
+
+    std::vector<std::size_t> trainCounts;
+    std::vector<std::size_t> testStarts;
+    std::vector<std::size_t> testCounts;
+    std::vector<double> params;
+    std::vector<double> rmse;
+    std::vector<double> mae;
+    double pooledRMSE = 0.0;   // Over every test value
+    double pooledMAE = 0.0;
+
+    std::size_t size() const { return rmse.size(); }
+    const double* getParams(std::size_t fold) const { return params.data() + fold * paramCount; }
+
+    std::string toString() const;
+};
+
+// Blocked cross-validation. The series is cut into folds + 1 contiguous
+// blocks and each fold fits on everything before its test block (less the
+// gap), then scores one-step forecasts across the block. Folds run in
+// parallel, warm-started from the full sample estimate.
+CrossValidationResult crossValidate(const std::vector<double>& values,
+                                    ModelType type,
+                                    int arOrder,
+                                    int maOrder,
+                                    const CrossValidationConfig& config = CrossValidationConfig());
+
+struct BootstrapConfig {
+    int replications = 200;
+    std::size_t blockLength = 0; // 0 uses the cube root of the residual count
+    double level = 0.95;         // Confidence level of the intervals
+    std::uint64_t seed = 0;
+    unsigned threadCount = 0;    // 0 uses every core
+};
+
+// Residual block bootstrap distribution of the parameters, replications x
+// paramCount row-major, with percentile intervals per parameter
+struct BootstrapResult {
+    ModelType type;
+    int arOrder;
+    int maOrder;
+    std::size_t paramCount;
+    double level;
+
+    ModelFit estimate;           // Full sample fit
+    std::vector<double> params;
+    std::vector<double> stdErr;
+    std::vector<double> lower;
+    std::vector<double> upper;
+
+    std::size_t size() const { return paramCount ? params.size() / paramCount : 0; }
+    const double* getParams(std::size_t replication) const { return params.data() + replication * paramCount; }
+
+    std::string toString() const;
+};
+
+// Refit the model to series rebuilt through the fitted recursion from
+// randomly placed blocks of its in-sample residuals, which keeps any
+// dependence the model leaves in them. Replications run in parallel,
+// warm-started from the full sample estimate, each with its own generator so
+// results depend on the seed but not on the thread count.
+BootstrapResult bootstrapParams(const std::vector<double>& values,
+                                ModelType type,
+                                int arOrder,
+                                int maOrder,
+                                const BootstrapConfig& config = BootstrapConfig());
+
+#endif // VALIDATION_HPP
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef VAR_HPP
+#define VAR_HPP
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "../types.hpp"
+#include "../time_utils.hpp"
+#include "../../third_party/Eigen/Dense"
+
+// Vector autoregression of k series,
+// y_t = c + A_1 * y_{t-1} + ... + A_p * y_{t-p} + e_t
+// fitted by least squares on all equations at once
+class VAR {
+private:
+    int lagOrder;
+    std::vector<std::string> names;
+    std::vector<std::time_t> dates;   // Dates of the aligned observations
+    std::time_t spacing;              // Median gap between dates, steps forecast dates
+    Eigen::MatrixXd values;           // Observations x series, each series contiguous
+
+    Eigen::MatrixXd coefficients;     // (1 + k * p) x k, intercepts then the lag 1..p blocks, one column per equation
+    Eigen::MatrixXd residuals;        // (n - p) x k
+    Eigen::MatrixXd covariance;       // Residual covariance
+    std::vector<double> rmse;         // Per equation
+
+    void setNames(const std::vector<std::string>& names);
+
+public:
+    // Align series on the dates present in all of them
+    VAR(const std::vector<TimeSeries<double>>& series, const std::vector<std::string>& names = {});
+    // Observations x series, dates optional
+    VAR(const Eigen::MatrixXd& values, const std::vector<std::time_t>& dates = {}, const std::vector<std::string>& names = {});
+
+    void train(int lagOrder);
+
+    // Forecast the next steps of every series, steps x series
+    Eigen::MatrixXd forecast(int steps) const;
+    void forecast(int steps, double* out) const; // Steps x series, column-major
+    TimeSeries<double> getForecasted(std::size_t series, int steps) const;
+
+    std::size_t getSeriesCount() const { return values.cols(); }
+    std::size_t getCount() const { return values.rows(); }
+    int getLagOrder() const { return lagOrder; }
+    const std::vector<std::string>& getNames() const { return names; }
+    const std::vector<std::time_t>& getDates() const { return dates; }
+    std::time_t getSpacing() const { return spacing; }
+    const Eigen::MatrixXd& getValues() const { return values; }
+
+    Eigen::VectorXd getIntercepts() const;
+    Eigen::MatrixXd getLagMatrix(int lag) const; // A_lag, row i is equation i
+    const Eigen::MatrixXd& getCoefficients() const { return coefficients; }
+    const Eigen::MatrixXd& getResiduals() const { return residuals; }
+    const Eigen::MatrixXd& getResidualCovariance() const { return covariance; }
+    const std::vector<double>& getRMSE() const { return rmse; }
+
+    std::string toString() const;
+};
+
+#endif // VAR_HPP
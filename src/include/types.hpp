@@ -14,4 +14,15 @@ enum class MovingAverageType {
     EMA
 };
 
+enum class ModelType {
+    AR,
+    MA,
+    ARMA
+};
+
+enum class InnovationType {
+    GAUSSIAN,
+    BOOTSTRAP
+};
+
 #endif // ENUMS_HPP
\ No newline at end of file
@@ -9,8 +9,9 @@ BollingerBands::BollingerBands(std::shared_ptr<PriceSeries> priceSeries, int per
     // Set table printing values
     std::string maTypeString = maType == MovingAverageType::SMA ? "SMA" : "EMA";
     name = fmt::format("BB({}d, {}σ, {})", period, numStdDev, maTypeString);
-    columnHeaders = {"Date", "Upper Band", "Middle Band", "Lower Band"};
+    columnHeaders = {"Date", "Lower Band", "Middle Band", "Upper Band"};
     columnWidths = {12, 12, 12, 12};
+    precision = 3;
 
     checkArguments();
     calculate();
@@ -31,12 +32,13 @@ void BollingerBands::checkArguments() {
 // TODO: In case of center band being SMA, seperate calculation is not needed
 // band can be calculated on the fly for window using sum
 void BollingerBands::calculate() {
-    const auto& dates = priceSeries->getDates();
     const auto& closes = priceSeries->getCloses();
 
-    const auto& mas = maType == MovingAverageType::SMA ?
-        priceSeries->getSMA(period)->getData() :
-        priceSeries->getEMA(period)->getData();
+    // Moving average values share our start, so bands and midline line up
+    // by position
+    std::vector<double> mas = maType == MovingAverageType::SMA ?
+        priceSeries->getSMA(period)->getValues() :
+        priceSeries->getEMA(period)->getValues();
 
     // Get std dev of first window 
     double sums = 0.0;
@@ -47,15 +49,14 @@ void BollingerBands::calculate() {
         squareSums += close * close;
     }
 
+    startIndex = period-1;
+    std::vector<double> lows(mas.size()), highs(mas.size());
     for (size_t i = period-1; i < closes.size(); ++i) {
         // Get std dev 
         double stdDev = std::sqrt((squareSums - sums * sums / period) / period);
-        const double ma = mas.at(dates[i]);
-        data[dates[i]] = {
-            ma - numStdDev * stdDev,
-            ma,
-            ma + numStdDev * stdDev
-        };
+        const double ma = mas[i - startIndex];
+        lows[i - startIndex] = ma - numStdDev * stdDev;
+        highs[i - startIndex] = ma + numStdDev * stdDev;
 
         // Update StdDev 
         if (i != closes.size()-1) {
@@ -65,43 +66,22 @@ void BollingerBands::calculate() {
             squareSums += close_i * close_i - close_i_period * close_i_period;
         }
     }
+    columns = {std::move(lows), std::move(mas), std::move(highs)};
 }
 
 void BollingerBands::plot() const {
     namespace plt = matplotlibcpp;
 
-    std::vector<double> xs, lows, mids, highs;
-    for (const auto& [date, val] : data) {
-        xs.push_back(date);
-        const auto& [low, mid, high] = val;
-        lows.push_back(low);
-        mids.push_back(mid);
-        highs.push_back(high);
-    }
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    std::vector<double> xs(dates.begin() + startIndex, dates.end());
+    const auto& lows = columns[0];
+    const auto& mids = columns[1];
+    const auto& highs = columns[2];
 
-    plt::fill_between(xs, lows, highs, {}, 0.2, 1);
-    plt::named_plot("BB midline", xs, mids);
-}
+    // Bands share the points chosen for the midline
+    std::vector<std::size_t> indices = getLTTBIndices(xs, mids, PLOT_POINTS);
+    xs = takeIndices(xs, indices);
 
-TimeSeries<std::vector<double>> BollingerBands::getDataMap() const {
-    TimeSeries<std::vector<double>> dataMap;
-    for (const auto& [date, val] : data) {
-        const auto& [low, mid, high] = val;
-        dataMap[date] = {low, mid, high};
-    }
-    return dataMap;
+    plt::fill_between(xs, takeIndices(lows, indices), takeIndices(highs, indices), {}, 0.2, 1);
+    plt::named_plot("BB midline", xs, takeIndices(mids, indices));
 }
-
-std::vector<std::vector<std::string>> BollingerBands::getTableData() const {
-    std::vector<std::vector<std::string>> tableData;
-    for (const auto& [date, val] : data) {
-        const auto& [low, mid, high] = val;
-        tableData.push_back({
-            epochToDateString(date),
-            fmt::format("{:.3f}", low),
-            fmt::format("{:.3f}", mid),
-            fmt::format("{:.3f}", high)
-        });
-    }
-    return tableData;
-} 
\ No newline at end of file
@@ -32,7 +32,6 @@ void EMA::checkArguments() {
 }
 
 void EMA::calculate() {
-    const std::vector<std::time_t>& dates = priceSeries->getDates();
     const std::vector<double> closes = priceSeries->getCloses();
 
     // Calculate SMA of first window
@@ -43,45 +42,37 @@ void EMA::calculate() {
     ema /= period;
 
     // Slide window until end of data
-    data[dates[period-1]] = ema;
+    startIndex = period-1;
+    std::vector<double> values;
+    values.reserve(closes.size() - startIndex);
+    values.push_back(ema);
     for (size_t i = period; i < closes.size(); i++) {
         ema = (closes[i] * smoothingFactor) + (ema * (1 - smoothingFactor));
-        data[dates[i]] = ema;
+        values.push_back(ema);
     }
+    columns = {std::move(values)};
 }
 
 void EMA::plot() const {
     namespace plt = matplotlibcpp;
 
-    std::vector<std::time_t> xs;
-    std::vector<double> ys;
-    for (const auto& [date, ema] : data) {
-        xs.push_back(date);
-        ys.push_back(ema);
-    }
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    std::vector<std::time_t> xs(dates.begin() + startIndex, dates.end());
+    std::vector<double> ys = columns[0];
+    decimateLTTB(xs, ys);
 
     plt::named_plot(name, xs, ys);   
 }
 
-std::vector<std::vector<std::string>> EMA::getTableData() const {
-    std::vector<std::vector<std::string>> tableData;
-    for (const auto& [date, ema] : data) {
-        tableData.push_back({
-            fmt::format(epochToDateString(date)),
-            fmt::format("{:.2f}", ema)
-        });
+const TimeSeries<double> EMA::getData() const {
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    TimeSeries<double> data;
+    for (size_t i = 0; i < columns[0].size(); ++i) {
+        data.emplace_hint(data.end(), dates[startIndex + i], columns[0][i]);
     }
-    return tableData;
+    return data;
 }
 
-TimeSeries<std::vector<double>> EMA::getDataMap() const {
-    TimeSeries<std::vector<double>> dataMap;
-    for (const auto& [date, ema] : data) {
-        dataMap[date] = {ema};
-    }
-    return dataMap;
+const std::vector<double>& EMA::getValues() const {
+    return columns[0];
 }
-
-const TimeSeries<double> EMA::getData() const {
-    return data;
-}
\ No newline at end of file
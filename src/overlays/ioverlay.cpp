@@ -0,0 +1,30 @@
+#include "overlays/ioverlay.hpp"
+#include "priceseries.hpp"
+
+std::vector<std::vector<std::string>> IOverlay::getTableData() const {
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    std::string dateText(getLength() * DATE_LENGTH, ' ');
+    formatDates(dates.data() + startIndex, getLength(), dateText.data());
+    std::vector<std::vector<std::string>> tableData;
+    for (size_t i = 0; i < getLength(); ++i) {
+        std::vector<std::string> row = {dateText.substr(i * DATE_LENGTH, DATE_LENGTH)};
+        for (const auto& column : columns) {
+            row.push_back(fmt::format("{:.{}f}", column[i], precision));
+        }
+        tableData.push_back(std::move(row));
+    }
+    return tableData;
+}
+
+TimeSeries<std::vector<double>> IOverlay::getDataMap() const {
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    TimeSeries<std::vector<double>> dataMap;
+    for (size_t i = 0; i < getLength(); ++i) {
+        std::vector<double> row;
+        for (const auto& column : columns) {
+            row.push_back(column[i]);
+        }
+        dataMap.emplace_hint(dataMap.end(), dates[startIndex + i], std::move(row));
+    }
+    return dataMap;
+}
@@ -21,88 +21,71 @@ void MACD::checkArguments() {
     if (aPeriod > count|| bPeriod > count|| cPeriod > count) {
         throw std::invalid_argument("Could not construct MACD: periods must be less than the number of data points");
     }
+    if (std::max(aPeriod, bPeriod) + cPeriod > count) {
+        throw std::invalid_argument("Could not construct MACD: not enough data points for the signal line");
+    }
 }
 
 void MACD::calculate() {
-    // Get MACD line
-    const TimeSeries<double> aData = priceSeries->getEMA(aPeriod)->getData();
-    const TimeSeries<double> bData = priceSeries->getEMA(bPeriod)->getData();
+    // Get MACD line, starting where both EMAs have values
+    const auto aEMA = priceSeries->getEMA(aPeriod);
+    const auto bEMA = priceSeries->getEMA(bPeriod);
+    const std::vector<double>& aValues = aEMA->getValues();
+    const std::vector<double>& bValues = bEMA->getValues();
+    const std::size_t aStart = aEMA->getStartIndex();
+    const std::size_t bStart = bEMA->getStartIndex();
+    const std::size_t macdStart = std::max(aStart, bStart);
 
-    TimeSeries<double> macd; // MACD = EMA_a - EMA_b
-    for (const auto& [date, bEMAvalue] : bData) {
-        if (aData.count(date)) {
-            macd[date] = aData.at(date) - bEMAvalue;
-        }
+    std::vector<double> macd(aStart + aValues.size() - macdStart); // MACD = EMA_a - EMA_b
+    for (size_t i = 0; i < macd.size(); ++i) {
+        macd[i] = aValues[macdStart + i - aStart] - bValues[macdStart + i - bStart];
     }
 
     // Signal line = EMA_c(MACD)
-    // Get first period sum
-    TimeSeries<double> signal;
+    // Get first period sum, the first signal value goes on the bar after
+    // the window
     double multiplier = 2.0 / (cPeriod + 1);
     double sum = 0.0;
-    auto it = macd.begin();
-    for (int i = 0; i < cPeriod; ++i, ++it) {
-        sum += it->second;
+    for (int i = 0; i < cPeriod; ++i) {
+        sum += macd[i];
     }
-    signal[it->first] = sum / cPeriod;
+    double signal = sum / cPeriod;
 
-    // Update window
-    for (++it; it != macd.end(); ++it) {
-        double value = (it->second - signal.rbegin()->second) * multiplier + signal.rbegin()->second;
-        signal[it->first] = value;
-    }
-
-    // Construct MACD data
-    for (const auto& [date, signalValue] : signal) {
-        double macdValue = macd.at(date);
-        data[date] = std::make_tuple(
-            macdValue,
-            signalValue,
-            macdValue - signalValue
-        );
+    // Update window and construct MACD data
+    startIndex = macdStart + cPeriod;
+    std::vector<double> signals(macd.size() - cPeriod), divergences(macd.size() - cPeriod);
+    for (size_t i = cPeriod; i < macd.size(); ++i) {
+        if (i > static_cast<size_t>(cPeriod)) {
+            signal = (macd[i] - signal) * multiplier + signal;
+        }
+        signals[i - cPeriod] = signal;
+        divergences[i - cPeriod] = macd[i] - signal;
     }
+    macd.erase(macd.begin(), macd.begin() + cPeriod);
+    columns = {std::move(macd), std::move(signals), std::move(divergences)};
 }
 
 void MACD::plot() const {
     // This needs to be a subplot
     namespace plt = matplotlibcpp;
-    std::vector<std::time_t> xs;
-    std::vector<double> macd, signal, divergence;
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    std::vector<std::time_t> xs(dates.begin() + startIndex, dates.end());
+    const auto& macd = columns[0];
+    const auto& signal = columns[1];
+    const auto& divergence = columns[2];
 
-    for (const auto& [date, val] : data) {
-        const auto& [macdVal, signalVal, divergenceVal] = val;
-        xs.push_back(date);
-        macd.push_back(macdVal);
-        signal.push_back(signalVal);
-        divergence.push_back(divergenceVal);
+    // Signal and divergence share the points chosen for the MACD line, bars
+    // widen to the spacing of the points kept
+    double width = DAY_INTERVAL.getSeconds();
+    std::vector<std::size_t> indices = getLTTBIndices(xs, macd, PLOT_POINTS);
+    if (indices.size() < xs.size()) {
+        width = static_cast<double>(xs.back() - xs.front()) / indices.size();
     }
+    xs = takeIndices(xs, indices);
 
-    plt::named_plot("MACD", xs, macd, "-");
-    plt::named_plot("Signal", xs, signal, "-");
-    plt::bar(xs, divergence, {}, intervalToSeconds("1d") * 0.8, 0, {"grey"});
+    plt::named_plot("MACD", xs, takeIndices(macd, indices), "-");
+    plt::named_plot("Signal", xs, takeIndices(signal, indices), "-");
+    plt::bar(xs, takeIndices(divergence, indices), {}, width * 0.8, 0, {"grey"});
     plt::legend();
-    plt::xlim(xs.front() - intervalToSeconds("1d"), xs.back() + intervalToSeconds("1d"));
+    plt::xlim(xs.front() - DAY_INTERVAL.getSeconds(), xs.back() + DAY_INTERVAL.getSeconds());
 }
-
-TimeSeries<std::vector<double>> MACD::getDataMap() const {
-    TimeSeries<std::vector<double>> dataMap;
-    for (const auto& [date, val] : data) {
-        const auto& [macd, signal, divergence] = val;
-        dataMap[date] = {macd, signal, divergence};
-    }
-    return dataMap;
-}
-
-std::vector<std::vector<std::string>> MACD::getTableData() const {
-    std::vector<std::vector<std::string>> tableData;
-    for (const auto& [date, val] : data) {
-        const auto& [macd, signal, divergence] = val;
-        tableData.push_back({
-            fmt::format(epochToDateString(date)),
-            fmt::format("{:.2f}", macd),
-            fmt::format("{:.2f}", signal),
-            fmt::format("{:.2f}", divergence)
-        });
-    }
-    return tableData;
-}
\ No newline at end of file
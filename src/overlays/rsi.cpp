@@ -24,7 +24,6 @@ void RSI::checkArguments() {
 
 void RSI::calculate() {
     // Get day-to-day returns
-    std::vector<std::time_t> dates = priceSeries->getDates();
     std::vector<double> closes = priceSeries->getCloses();
     std::vector<double> returns(closes.size() - 1);
     for (size_t i = 1; i < closes.size(); ++i) {
@@ -44,10 +43,13 @@ void RSI::calculate() {
     avgGain /= period;
 
     // Slide window and calculate RSI 
+    startIndex = period-1;
+    std::vector<double> values;
+    values.reserve(returns.size() - startIndex);
     for (size_t i = period-1; i < returns.size(); ++i) {
         double rs = avgGain / avgLoss;
         double rsi = 100 - (100 / (1 + rs));
-        data[dates[i]] = rsi;
+        values.push_back(rsi);
 
         // Update gains and losses
         double r = returns[i];
@@ -57,16 +59,15 @@ void RSI::calculate() {
         avgGain = ((avgGain * (period - 1)) + gain) / period;
         avgLoss = ((avgLoss * (period - 1)) + loss) / period;
     }
+    columns = {std::move(values)};
 }
 
 void RSI::plot() const {
     namespace plt = matplotlibcpp;
-    std::vector<std::time_t> xs;
-    std::vector<double> ys;
-    for (const auto& [date, rsi] : data) {
-        xs.push_back(date);
-        ys.push_back(rsi);
-    }
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    std::vector<std::time_t> xs(dates.begin() + startIndex, dates.begin() + startIndex + getLength());
+    std::vector<double> ys = columns[0];
+    decimateLTTB(xs, ys);
 
     plt::plot(xs, ys, "-");
     std::map<std::string, std::string> kwargs;
@@ -74,26 +75,7 @@ void RSI::plot() const {
     kwargs["linestyle"] = "--";
     plt::axhline(70, 0., 1., kwargs);
     plt::axhline(30, 0., 1., kwargs);
-    plt::xlim(xs.front() - intervalToSeconds("1d"), xs.back() + intervalToSeconds("1d"));
+    plt::xlim(xs.front() - DAY_INTERVAL.getSeconds(), xs.back() + DAY_INTERVAL.getSeconds());
     plt::ylabel("RSI");
     plt::ylim(0, 100);
 }
-
-TimeSeries<std::vector<double>> RSI::getDataMap() const {
-    TimeSeries<std::vector<double>> dataMap;
-    for (const auto& [date, rsi] : data) {
-        dataMap[date] = {rsi};
-    }
-    return dataMap;
-}
-
-std::vector<std::vector<std::string>> RSI::getTableData() const {
-    std::vector<std::vector<std::string>> tableData;
-    for (const auto& [date, rsi] : data) {
-        tableData.push_back({
-            fmt::format(epochToDateString(date)),
-            fmt::format("{:.2f}", rsi)
-        });
-    }
-    return tableData;
-}
\ No newline at end of file
@@ -23,7 +23,6 @@ void SMA::checkArguments() {
 }
 
 void SMA::calculate() {
-    const std::vector<std::time_t> dates = priceSeries->getDates();
     const std::vector<double> closes = priceSeries->getCloses();
 
     // Get first window 
@@ -34,44 +33,36 @@ void SMA::calculate() {
     sma /= period;
 
     // Slide window until end of data
-    data[dates[period-1]] = sma;
+    startIndex = period-1;
+    std::vector<double> values;
+    values.reserve(closes.size() - startIndex);
+    values.push_back(sma);
     for (size_t i = period; i < closes.size(); ++i) {
         sma += (closes[i] - closes[i-period]) / period;
-        data[dates[i]] = sma;
+        values.push_back(sma);
     }
+    columns = {std::move(values)};
 }
 
 void SMA::plot() const {
     namespace plt = matplotlibcpp;
-    std::vector<std::time_t> xs;
-    std::vector<double> ys;
-    for (const auto& [date, sma] : data) {
-        xs.push_back(date);
-        ys.push_back(sma);
-    }
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    std::vector<std::time_t> xs(dates.begin() + startIndex, dates.end());
+    std::vector<double> ys = columns[0];
+    decimateLTTB(xs, ys);
 
     plt::named_plot(name, xs, ys);
 }
 
-TimeSeries<std::vector<double>> SMA::getDataMap() const {
-    TimeSeries<std::vector<double>> dataMap;
-    for (const auto& [date, sma] : data) {
-        dataMap[date] = {sma};
+const TimeSeries<double> SMA::getData() const {
+    const std::vector<std::time_t> dates = priceSeries->getDates();
+    TimeSeries<double> data;
+    for (size_t i = 0; i < columns[0].size(); ++i) {
+        data.emplace_hint(data.end(), dates[startIndex + i], columns[0][i]);
     }
-    return dataMap;
+    return data;
 }
 
-std::vector<std::vector<std::string>> SMA::getTableData() const {
-    std::vector<std::vector<std::string>> tableData;
-    for (const auto& [date, sma] : data) {
-        tableData.push_back({
-            fmt::format(epochToDateString(date)),
-            fmt::format("{:.2f}", sma)
-        });
-    }
-    return tableData;
+const std::vector<double>& SMA::getValues() const {
+    return columns[0];
 }
-
-const TimeSeries<double> SMA::getData() const {
-    return data;
-}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "priceseries.hpp"
+#include "decimation.hpp"
+#include "thread_utils.hpp"
 
 #include "overlays/ioverlay.hpp"
 #include "overlays/bollinger.hpp"
@@ -9,10 +11,10 @@
 
 PriceSeries::PriceSeries() = default;
 PriceSeries::~PriceSeries() = default;
-PriceSeries::PriceSeries(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval)
+PriceSeries::PriceSeries(const DataProvider& provider, const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval)
     : ticker(ticker), start(start), end(end), interval(interval) {
     checkArguments();
-    fetchData();
+    fetchData(provider);
 }
 
 void PriceSeries::checkArguments() {
@@ -47,16 +49,25 @@ void PriceSeries::checkArguments() {
     }
 }
 
-void PriceSeries::fetchData() {
-    namespace plt = matplotlibcpp;
-    plt::scrape(ticker, epochToDateString(start), epochToDateString(end),
-                dates, opens, highs, lows, closes, adjCloses, volumes);
+void PriceSeries::fetchData(const DataProvider& provider) {
+    setData(provider.fetch(ticker, start, end, interval));
+}
+
+void PriceSeries::setData(PriceData&& data) {
+    dates = std::move(data.dates);
+    opens = std::move(data.opens);
+    highs = std::move(data.highs);
+    lows = std::move(data.lows);
+    closes = std::move(data.closes);
+    adjCloses = std::move(data.adjCloses);
+    volumes = std::move(data.volumes);
     count = dates.size();
 }
 
 void plotLine(const std::vector<std::time_t>& xs, const std::vector<double>& ys) {
     namespace plt = matplotlibcpp;
-    plt::named_plot("Price", xs, ys);
+    std::vector<std::size_t> indices = getLTTBIndices(xs, ys, PLOT_POINTS);
+    plt::named_plot("Price", takeIndices(xs, indices), takeIndices(ys, indices));
 }
 
 void plotCandleStick(const std::vector<std::time_t>& xs,
@@ -93,35 +104,56 @@ void plotCandleStick(const std::vector<std::time_t>& xs,
 
 void plotArea(const std::vector<std::time_t>& xs, const std::vector<double>& ys) {
     namespace plt = matplotlibcpp;
-    std::vector<double> zeros(ys.size(), 0.0);
+    std::vector<std::size_t> indices = getLTTBIndices(xs, ys, PLOT_POINTS);
+    std::vector<double> zeros(indices.size(), 0.0);
     std::map<std::string, std::string> kwargs = {
         {"color", "darkblue"}
     };
-    plt::fill_between(xs, ys, zeros, kwargs, 0.2, 0);
+    plt::fill_between(takeIndices(xs, indices), takeIndices(ys, indices), zeros, kwargs, 0.2, 0);
     plt::ylim(*std::min_element(ys.begin(), ys.end()) * 0.95, *std::max_element(ys.begin(), ys.end()) * 1.05);
 }
 
 void PriceSeries::plot(const std::string& type, const bool includeVolume, const std::string& savePath) const {
+    namespace plt = matplotlibcpp;
+    plt::figure_size(1200, 800);
+    draw(type, includeVolume, [](long row, long rowSpan) {
+        plt::subplot2grid(5, 1, row, 0, rowSpan, 1);
+    });
+    plt::tight_layout();
+
+    if (savePath != "") {
+        plt::save(savePath, 300);
+    } else {
+        plt::show();
+    }
+}
+
+void PriceSeries::draw(const std::string& type, const bool includeVolume, const std::function<void(long, long)>& selectPanel) const {
     // Plot assumptions, only plot a single RSI and MACD subplot
     // Each subplot is given 1/5 of the height
     namespace plt = matplotlibcpp;
     const auto& [ticks, labels] = getTicks(dates.front(), dates.back(), 6);
     int priceHeight = 5 - includeVolume - includeRSI - includeMACD;
 
+    // Candles and volume bars are merged into buckets a few pixels wide
+    OHLCBars bars;
+    if (type == "candlestick" || includeVolume) {
+        bars = decimateOHLC(dates, opens, highs, lows, closes, volumes);
+    }
+
     // Make main price plot
-    plt::figure_size(1200, 800);
-    plt::subplot2grid(5, 1, 0, 0, priceHeight, 1);
+    selectPanel(0, priceHeight);
     plt::ylabel("Price ($)");
     if (type == "line") {
         plotLine(dates, closes);
     } else if (type == "candlestick") {
-        plotCandleStick(dates, opens, highs, lows, closes, intervalToSeconds("1d")*0.8);
+        plotCandleStick(bars.dates, bars.opens, bars.highs, bars.lows, bars.closes, bars.width*0.8);
     } else if (type == "area") {
         plotArea(dates, closes);
     }
     plt::title(ticker);
     plt::grid(true);
-    plt::xlim(dates.front() - intervalToSeconds("1d"), dates.back() + intervalToSeconds("1d"));
+    plt::xlim(dates.front() - DAY_INTERVAL.getSeconds(), dates.back() + DAY_INTERVAL.getSeconds());
 
     if (priceHeight == 5) {
         plt::xticks(ticks, labels);
@@ -138,9 +170,9 @@ void PriceSeries::plot(const std::string& type, const bool includeVolume, const
     }
 
     if (includeVolume) {
-        plt::subplot2grid(5, 1, priceHeight, 0, 1, 1);
-        plt::bar(dates, volumes, {}, intervalToSeconds("1d")*0.8, 0);
-        plt::xlim(dates.front() - intervalToSeconds("1d"), dates.back() + intervalToSeconds("1d"));
+        selectPanel(priceHeight, 1);
+        plt::bar(bars.dates, bars.volumes, {}, bars.width*0.8, 0);
+        plt::xlim(dates.front() - DAY_INTERVAL.getSeconds(), dates.back() + DAY_INTERVAL.getSeconds());
         plt::ylabel("Volume");
         priceHeight++;
         if (priceHeight == 5) {
@@ -152,7 +184,7 @@ void PriceSeries::plot(const std::string& type, const bool includeVolume, const
     
     // Plot RSI and MACD overlays
     if (includeRSI) {
-        plt::subplot2grid(5, 1, priceHeight, 0, 1, 1);
+        selectPanel(priceHeight, 1);
         for (const auto& overlay : overlays) {
             if (overlay->getName().find("RSI") == 0) {
                 overlay->plot();
@@ -168,7 +200,7 @@ void PriceSeries::plot(const std::string& type, const bool includeVolume, const
 
     }
     if (includeMACD) {
-        plt::subplot2grid(5, 1, priceHeight, 0, 1, 1);
+        selectPanel(priceHeight, 1);
         for (const auto& overlay : overlays) {
             if (overlay->getName().find("MACD") == 0) {
                 overlay->plot();
@@ -181,20 +213,15 @@ void PriceSeries::plot(const std::string& type, const bool includeVolume, const
             plt::xticks(std::vector<double>(), std::vector<std::string>());
         }
     }
-    plt::tight_layout();
-
-    if (savePath != "") {
-        plt::save(savePath, 300);
-    } else {
-        plt::show();
-    }
 }
 
 std::vector<std::vector<std::string>> PriceSeries::getTableData() const {
+    std::string dateText(dates.size() * DATE_LENGTH, ' ');
+    formatDates(dates.data(), dates.size(), dateText.data());
     std::vector<std::vector<std::string>> tableData;
     for (size_t i = 0; i < dates.size(); ++i) {
         tableData.push_back({
-            epochToDateString(dates[i]),
+            dateText.substr(i * DATE_LENGTH, DATE_LENGTH),
             fmt::format("{:.3f}", opens[i]),
             fmt::format("{:.3f}", highs[i]),
             fmt::format("{:.3f}", lows[i]),
@@ -206,49 +233,67 @@ std::vector<std::vector<std::string>> PriceSeries::getTableData() const {
     return tableData;
 }
 
-std::string PriceSeries::toString(bool includeOverlays, bool changeHighlighting) const {
-    std::vector<int> columnWidths = {12, 10, 10, 10, 10, 12, 12};
-    std::vector<std::string> columnHeaders = {"Date", "Open", "High", "Low", "Close", "adjClose", "Volume"};
-    std::vector<std::vector<std::string>> tableData = getTableData();
-
+NumericTable PriceSeries::getNumericTable(bool includeOverlays) const {
+    NumericTable table(ticker, dates.size());
+    table.setLabels("Date", 12, [this](std::size_t i) { return epochToDateString(dates[i]); });
+    table.addColumn("Open", 10, opens.data());
+    table.addColumn("High", 10, highs.data());
+    table.addColumn("Low", 10, lows.data());
+    table.addColumn("Close", 10, closes.data());
+    table.addColumn("adjClose", 12, adjCloses.data());
+    table.addColumn("Volume", 12, volumes.data());
     if (includeOverlays) {
         for (const auto& overlay : overlays) {
-            const auto& overlayData = overlay->getDataMap();
-            // Find size of value vectors 
-            std::size_t n = overlayData.begin()->second.size();
-
-            // Add column headers and widths
-            const auto& newHeaders = overlay->getColumnHeaders();
-            const auto& newWidths = overlay->getColumnWidths();
-            for (size_t i = 0; i < n; ++i) {
-                columnHeaders.push_back(newHeaders[i+1]);
-                columnWidths.push_back(newWidths[i+1]);
-            }
-
-            size_t dateCount = dates.size();
-            for (size_t i = 0; i < dateCount; ++i) {
-                const auto& date = dates[i];
-                // Check if a corresponding entry exists in the overlay data map
-                if (overlayData.find(date) != overlayData.end()) {
-                    // Add n overlay datapoints to row
-                    for (const auto& overlayVal : overlayData.at(date)) {
-                        tableData.at(i).push_back(fmt::format("{:.3f}", overlayVal));
-                    }
-                } else {
-                    // If not, add n blank datapoints to row
-                    for (size_t j = 0; j < n; ++j) {
-                        tableData.at(i).push_back(" ");
-                    }
-                }
+            const auto& widths = overlay->getColumnWidths();
+            for (size_t j = 0; j < overlay->getWidth(); ++j) {
+                table.addColumn(overlay->getColumnName(j), widths[j+1], overlay->getColumn(j).data(),
+                                overlay->getStartIndex(), overlay->getLength());
             }
         }
     }
-    return getTable(ticker, tableData, columnWidths, columnHeaders, changeHighlighting);
+    return table;
+}
+
+std::string PriceSeries::toString(bool includeOverlays, bool changeHighlighting) const {
+    return getNumericTable(includeOverlays).toString(changeHighlighting);
+}
+
+std::string PriceSeries::getHead(std::size_t rows, bool includeOverlays, bool changeHighlighting) const {
+    return getNumericTable(includeOverlays).getPage(0, rows, changeHighlighting);
+}
+
+std::string PriceSeries::getTail(std::size_t rows, bool includeOverlays, bool changeHighlighting) const {
+    std::size_t first = dates.size() - std::min(rows, dates.size());
+    return getNumericTable(includeOverlays).getPage(first, rows, changeHighlighting);
+}
+
+void PriceSeries::print(std::ostream& out, bool includeOverlays, bool changeHighlighting) const {
+    getNumericTable(includeOverlays).write(out, changeHighlighting);
 }
 
 // Factory methods -------------------------------------------------------------
+static std::mutex providerMutex;
+static std::shared_ptr<DataProvider> dataProvider = std::make_shared<YahooProvider>();
+
+void PriceSeries::setDataProvider(std::shared_ptr<DataProvider> provider) {
+    if (!provider) {
+        throw std::invalid_argument("Could not set data provider. Provider is null");
+    }
+    std::lock_guard<std::mutex> lock(providerMutex);
+    dataProvider = std::move(provider);
+}
+
+std::shared_ptr<DataProvider> PriceSeries::getDataProvider() {
+    std::lock_guard<std::mutex> lock(providerMutex);
+    return dataProvider;
+}
+
+std::unique_ptr<PriceSeries> PriceSeries::getPriceSeries(const DataProvider& provider, const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) {
+    return std::unique_ptr<PriceSeries>(new PriceSeries(provider, ticker, start, end, interval));
+}
+
 std::unique_ptr<PriceSeries> PriceSeries::getPriceSeries(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) {
-    return std::unique_ptr<PriceSeries>(new PriceSeries(ticker, start, end, interval));
+    return getPriceSeries(*getDataProvider(), ticker, start, end, interval);
 }
 
 std::unique_ptr<PriceSeries> PriceSeries::getPriceSeries(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval) {
@@ -274,9 +319,55 @@ std::unique_ptr<PriceSeries> PriceSeries::getPriceSeries(const std::string& tick
     return getPriceSeries(ticker, startTime, end, interval);
 }
 
+std::vector<std::unique_ptr<PriceSeries>> PriceSeries::getPriceSeriesBatch(const std::vector<std::string>& tickers, const std::time_t start, const std::time_t end, const std::string& interval, const std::function<void(PriceSeries&)>& prepare, unsigned threadCount) {
+    if (tickers.empty()) {
+        throw std::invalid_argument("Could not get PriceSeries batch. No tickers given");
+    }
+
+    std::vector<std::unique_ptr<PriceSeries>> batch;
+    for (const auto& ticker : tickers) {
+        std::unique_ptr<PriceSeries> series(new PriceSeries());
+        series->ticker = ticker;
+        series->start = start;
+        series->end = end;
+        series->interval = interval;
+        series->checkArguments();
+        batch.push_back(std::move(series));
+    }
+
+    std::shared_ptr<DataProvider> provider = getDataProvider();
+    const std::time_t batchEnd = batch.front()->end;
+    auto land = [&](std::size_t i, PriceData& data) {
+        batch[i]->setData(std::move(data));
+    };
+
+    if (!prepare) {
+        provider->fetchBatch(tickers, start, batchEnd, interval, land);
+        return batch;
+    }
+
+    // Fetching stays on this thread, which may hold the interpreter
+    pipeline(threadCount,
+        [&](auto&& emit) {
+            provider->fetchBatch(tickers, start, batchEnd, interval, [&](std::size_t i, PriceData& data) {
+                land(i, data);
+                emit(i);
+            });
+        },
+        [&](std::size_t i, unsigned) {
+            prepare(*batch[i]);
+        });
+    return batch;
+}
+
+std::vector<std::unique_ptr<PriceSeries>> PriceSeries::getPriceSeriesBatch(const std::vector<std::string>& tickers, const std::string& start, const std::string& end, const std::string& interval, const std::function<void(PriceSeries&)>& prepare, unsigned threadCount) {
+    return getPriceSeriesBatch(tickers, dateStringToEpoch(start), dateStringToEpoch(end), interval, prepare, threadCount);
+}
+
 // Getters ---------------------------------------------------------------------
 int PriceSeries::getCount() const { return count; }
 const std::string PriceSeries::getTicker() const { return ticker; }
+const std::string PriceSeries::getInterval() const { return interval; }
 const std::vector<std::time_t> PriceSeries::getDates() const { return dates; }
 const std::vector<double> PriceSeries::getOpens() const { return opens; }
 const std::vector<double> PriceSeries::getHighs() const { return highs;}
@@ -285,6 +376,58 @@ const std::vector<double> PriceSeries::getCloses() const { return closes; }
 const std::vector<double> PriceSeries::getAdjCloses() const { return adjCloses; }
 const std::vector<long> PriceSeries::getVolumes() const { return volumes;}
 
+// Resampling ------------------------------------------------------------------
+std::unique_ptr<PriceSeries> PriceSeries::resample(const Interval& interval) const {
+    const std::size_t n = dates.size();
+    if (opens.size() != n || highs.size() != n || lows.size() != n ||
+        closes.size() != n || adjCloses.size() != n || volumes.size() != n) {
+        throw std::invalid_argument("Could not resample: price columns have different lengths");
+    }
+    if (!this->interval.empty()) {
+        const Interval source = Interval::fromString(this->interval);
+        if (source.getSeconds() > interval.getSeconds()) {
+            throw std::invalid_argument("Could not resample: interval " + interval.toString() + " is finer than " + this->interval);
+        }
+        // Fixed length buckets must hold a whole number of source bars
+        const Interval::Unit unit = interval.getUnit();
+        if ((unit == Interval::Unit::MINUTE || unit == Interval::Unit::HOUR || unit == Interval::Unit::DAY) &&
+            interval.getSeconds() % source.getSeconds() != 0) {
+            throw std::invalid_argument("Could not resample: interval " + interval.toString() + " is not a whole multiple of " + this->interval);
+        }
+    }
+
+    // Bars are in date order, so each bucket is a run of bars and its end
+    // is only looked up when a new one starts
+    PriceData data;
+    std::time_t bucketEnd = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i == 0 || dates[i] >= bucketEnd) {
+            data.dates.push_back(interval.getBucketStart(dates[i]));
+            data.opens.push_back(opens[i]);
+            data.highs.push_back(highs[i]);
+            data.lows.push_back(lows[i]);
+            data.closes.push_back(closes[i]);
+            data.adjCloses.push_back(adjCloses[i]);
+            data.volumes.push_back(volumes[i]);
+            bucketEnd = interval.getBucketEnd(dates[i]);
+            continue;
+        }
+        data.highs.back() = std::max(data.highs.back(), highs[i]);
+        data.lows.back() = std::min(data.lows.back(), lows[i]);
+        data.closes.back() = closes[i];
+        data.adjCloses.back() = adjCloses[i];
+        data.volumes.back() += volumes[i];
+    }
+
+    auto resampled = std::make_unique<PriceSeries>();
+    resampled->ticker = ticker;
+    resampled->start = start;
+    resampled->end = end;
+    resampled->interval = interval.toString();
+    resampled->setData(std::move(data));
+    return resampled;
+}
+
 // Overlays --------------------------------------------------------------------
 void PriceSeries::addOverlay(const std::shared_ptr<IOverlay> overlay) {
     overlays.push_back(std::move(overlay));
@@ -376,6 +519,60 @@ const std::shared_ptr<ARMA> PriceSeries::getARMA(int arOrder, int maOrder) const
     return std::make_shared<ARMA>(arma);
 }
 
+const std::shared_ptr<ARIMA> PriceSeries::getARIMA(int arOrder, int diffOrder, int maOrder) const {
+    // Make data timeseries 
+    TimeSeries<double> data;
+    for (size_t i = 0; i < closes.size(); ++i) {
+        data[dates[i]] = closes[i];
+    }
+
+    ARIMA arima(data);
+    arima.train(arOrder, diffOrder, maOrder);
+
+    return std::make_shared<ARIMA>(arima);
+}
+
+const std::shared_ptr<GARCH> PriceSeries::getGARCH(int arOrder, int maOrder) const {
+    // Make percentage log return timeseries, keyed by the later date
+    TimeSeries<double> data;
+    for (size_t i = 1; i < closes.size(); ++i) {
+        data[dates[i]] = 100.0 * std::log(closes[i] / closes[i - 1]);
+    }
+
+    GARCH garch(data);
+    garch.train(arOrder, maOrder);
+
+    return std::make_shared<GARCH>(garch);
+}
+
+const std::shared_ptr<HoltWinters> PriceSeries::getHoltWinters(int period) const {
+    // Make data timeseries 
+    TimeSeries<double> data;
+    for (size_t i = 0; i < closes.size(); ++i) {
+        data[dates[i]] = closes[i];
+    }
+
+    HoltWinters holtWinters(data);
+    holtWinters.train(period);
+
+    return std::make_shared<HoltWinters>(holtWinters);
+}
+
+std::vector<double> PriceSeries::getACF(int maxLag, bool useReturns) const {
+    if (!useReturns) {
+        return ::getACF(closes, maxLag);
+    }
+    std::vector<double> returns;
+    for (size_t i = 1; i < closes.size(); ++i) {
+        returns.push_back(std::log(closes[i] / closes[i - 1]));
+    }
+    return ::getACF(returns, maxLag);
+}
+
+std::vector<double> PriceSeries::getPACF(int maxLag, bool useReturns) const {
+    return ::getPACF(getACF(maxLag, useReturns));
+}
+
 // Exports ---------------------------------------------------------------------
 void PriceSeries::exportCSV(const std::string& filename, 
                               const char delimiter, 
@@ -391,24 +588,16 @@ void PriceSeries::exportCSV(const std::string& filename,
     std::vector<std::vector<std::string>> tableData = getTableData();
     if (includeOverlays) {
         for (const auto& overlay : overlays) {
-            const auto& overlayData = overlay->getDataMap();
-            // Find size of value vectors 
-            std::size_t n = overlayData.begin()->second.size();
+            const auto& columns = overlay->getColumns();
+            std::size_t start = overlay->getStartIndex();
+            std::size_t end = start + overlay->getLength();
 
+            // Overlay columns are aligned to our bars from the overlay's
+            // start, blank datapoints before and after
             size_t dateCount = dates.size();
             for (size_t i = 0; i < dateCount; ++i) {
-                const auto& date = dates[i];
-                // Check if corresponding entry exists in the overlay data map
-                if (overlayData.find(date) != overlayData.end()) {
-                    // Add n overlay datapoints to row
-                    for (const auto& overlayVal : overlayData.at(date)) {
-                        tableData.at(i).push_back(fmt::format("{:.2f}", overlayVal));
-                    }
-                } else {
-                    // If not, add n blank datapoints to row
-                    for (size_t j = 0; j < n; ++j) {
-                        tableData.at(i).push_back("");
-                    }
+                for (const auto& column : columns) {
+                    tableData[i].push_back(i >= start && i < end ? fmt::format("{:.2f}", column[i - start]) : "");
                 }
             }
         }
@@ -1,24 +1,26 @@
 #include "print_utils.hpp"
 #include <iostream>
 #include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
 
-bool isNumber(const std::string& str) {
+// Rows rendered before a streamed table is flushed
+constexpr std::size_t TABLE_CHUNK_ROWS = 4096;
+
+// Parse a whole string as a number in one pass, without exceptions
+bool parseNumber(const std::string& str, double& value) {
     // Check if the string is empty or consists only of whitespace
     if (str.empty() || std::all_of(str.begin(), str.end(), isspace)) {
         return false;
     }
 
-    // Try to convert the string to a double
-    try {
-        std::size_t pos;
-        std::stod(str, &pos);
-        // Check if the entire string was converted
-        return pos == str.size();
-    } catch (const std::invalid_argument& e) {
-        return false;
-    } catch (const std::out_of_range& e) {
-        return false;
-    }
+    // Check if the entire string was converted
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(str.c_str(), &end);
+    return end == str.c_str() + str.size() && errno != ERANGE;
 }
 
 std::string colorToAnsi(Color color) {
@@ -123,6 +125,9 @@ std::string getTable(const std::string& title,
                      bool changeHighlighting) {
     std::string table;
     size_t colCount = columnWidths.size();
+    if (!tableData.empty()) {
+        table.reserve(tableData.size() * (tableData.front().size() * 24 + 4));
+    }
     std::vector<Color> colors(colCount, Color::WHITE);
     std::vector<Justification> justifications = {Justification::LEFT};
     int totalWidth = colCount - 1;
@@ -140,21 +145,16 @@ std::string getTable(const std::string& title,
     table += getMidLine(columnWidths, Ticks::BOTH);
 
     // Conditionally update column colors based on whether value is (in/de)creasing
-    std::vector<double> previous;
-    if (changeHighlighting) {
-        for (size_t i = 1; i < colCount; ++i) {
-            // Find first entry in each column 
-            int j = 0;
-            while (!isNumber(tableData[j][i])) { j++; }
-            previous.push_back(std::stod(tableData[j][i]));
-        }
-    }
+    // Columns start from their first number, so it prints white
+    std::vector<double> previous(colCount, NAN);
     for (const auto& row : tableData) {
         if (changeHighlighting) {
             for (size_t i = 1; i < colCount; ++i) {
                 double current = 0.0;
-                if (isNumber(row[i])) {
-                    current = std::stod(row[i]);
+                if (parseNumber(row[i], current)) {
+                    if (std::isnan(previous[i - 1])) {
+                        previous[i - 1] = current;
+                    }
 
                     // Compare and set color
                     if (current > previous[i - 1]) {
@@ -174,4 +174,191 @@ std::string getTable(const std::string& title,
     }
     table += getBottomLine(columnWidths);
     return table;
-}
\ No newline at end of file
+}
+
+NumericTable::NumericTable(const std::string& title, std::size_t rowCount)
+    : title(title), rowCount(rowCount) {}
+
+void NumericTable::setLabels(const std::string& header, int width, std::function<std::string(std::size_t)> label) {
+    this->labelHeader = header;
+    this->labelWidth = width;
+    this->label = std::move(label);
+}
+
+void NumericTable::addColumn(const std::string& header, int width, const double* values, int precision) {
+    TableColumn column{header, width};
+    column.values = values;
+    column.precision = precision;
+    columns.push_back(column);
+}
+
+void NumericTable::addColumn(const std::string& header, int width, const double* values, std::size_t first, std::size_t count, int precision) {
+    TableColumn column{header, width};
+    column.values = values;
+    column.precision = precision;
+    column.first = first;
+    column.count = count;
+    columns.push_back(column);
+}
+
+void NumericTable::addColumn(const std::string& header, int width, const long* values) {
+    TableColumn column{header, width};
+    column.integers = values;
+    column.precision = 0;
+    columns.push_back(column);
+}
+
+std::vector<int> NumericTable::getColumnWidths() const {
+    std::vector<int> widths;
+    if (label) {
+        widths.push_back(labelWidth);
+    }
+    for (const auto& column : columns) {
+        widths.push_back(column.width);
+    }
+    return widths;
+}
+
+std::size_t NumericTable::getRowBytes() const {
+    // Cell text, color codes and a three byte border per cell, then the
+    // closing border and newline
+    std::size_t bytes = 4;
+    for (int width : getColumnWidths()) {
+        bytes += width + colorToAnsi(Color::WHITE).size() + colorToAnsi(Color::RESET).size() + V_LINE.size();
+    }
+    return bytes;
+}
+
+void NumericTable::writeHeader(std::string& out) const {
+    std::vector<int> widths = getColumnWidths();
+    int totalWidth = widths.size() - 1;
+    std::vector<std::string> headers;
+    std::vector<Justification> justifications;
+    if (label) {
+        headers.push_back(labelHeader);
+        justifications.push_back(Justification::LEFT);
+    }
+    for (const auto& column : columns) {
+        headers.push_back(column.header);
+        justifications.push_back(headers.size() == 1 ? Justification::LEFT : Justification::RIGHT);
+    }
+    for (int width : widths) {
+        totalWidth += width;
+    }
+
+    out += getTopLine({totalWidth});
+    out += getRow({title}, {totalWidth}, {Justification::CENTER}, {Color::WHITE}); // Title
+    out += getMidLine(widths, Ticks::LOWER);
+    out += getRow(headers, widths, justifications, std::vector<Color>(widths.size(), Color::WHITE)); // Headers
+    out += getMidLine(widths, Ticks::BOTH);
+}
+
+void NumericTable::writeFooter(std::string& out) const {
+    out += getBottomLine(getColumnWidths());
+}
+
+void NumericTable::writeEllipsis(std::string& out) const {
+    std::vector<int> widths = getColumnWidths();
+    std::vector<std::string> cells(widths.size(), "...");
+    std::vector<Justification> justifications(widths.size(), Justification::RIGHT);
+    justifications[0] = Justification::LEFT;
+    out += getRow(cells, widths, justifications, std::vector<Color>(widths.size(), Color::WHITE));
+}
+
+void NumericTable::writeRows(std::string& out, std::size_t first, std::size_t last, bool changeHighlighting) const {
+    const std::string& white = colorToAnsi(Color::WHITE);
+    const std::string& reset = colorToAnsi(Color::RESET);
+    const std::string& green = colorToAnsi(Color::GREEN);
+    const std::string& red = colorToAnsi(Color::RED);
+
+    // Each column compares against its last number before the first row, or
+    // its first number when there is none
+    std::vector<double> previous(columns.size(), NAN);
+    if (changeHighlighting) {
+        for (std::size_t j = 0; j < columns.size(); ++j) {
+            for (std::size_t i = first; i-- > 0 && std::isnan(previous[j]);) {
+                previous[j] = columns[j].getValue(i);
+            }
+        }
+    }
+
+    auto inserter = std::back_inserter(out);
+    for (std::size_t i = first; i < last; ++i) {
+        out += V_LINE;
+        if (label) {
+            fmt::format_to(inserter, "{}{:<{}}{}", white, label(i), labelWidth, reset);
+        }
+        for (std::size_t j = 0; j < columns.size(); ++j) {
+            const TableColumn& column = columns[j];
+            if (label || j > 0) {
+                out += V_LINE;
+            }
+
+            double value = column.getValue(i);
+            if (std::isnan(value)) {
+                fmt::format_to(inserter, "{}{:>{}}{}", white, "", column.width, reset);
+                continue;
+            }
+            const std::string* color = &white;
+            if (changeHighlighting) {
+                if (std::isnan(previous[j])) {
+                    previous[j] = value;
+                }
+                color = value > previous[j] ? &green : value < previous[j] ? &red : &white;
+                previous[j] = value;
+            }
+            if (column.integers) {
+                fmt::format_to(inserter, "{}{:>{}}{}", *color, column.integers[i - column.first], column.width, reset);
+            } else {
+                fmt::format_to(inserter, "{}{:>{}.{}f}{}", *color, value, column.width, column.precision, reset);
+            }
+        }
+        out += V_LINE;
+        out += '\n';
+    }
+}
+
+std::string NumericTable::toString(bool changeHighlighting) const {
+    return getPage(0, rowCount, changeHighlighting);
+}
+
+std::string NumericTable::getPage(std::size_t first, std::size_t count, bool changeHighlighting) const {
+    first = std::min(first, rowCount);
+    std::size_t last = first + std::min(count, rowCount - first);
+
+    std::string out;
+    out.reserve((last - first + 8) * getRowBytes());
+    writeHeader(out);
+    writeRows(out, first, last, changeHighlighting);
+    writeFooter(out);
+    return out;
+}
+
+std::string NumericTable::getHeadTail(std::size_t head, std::size_t tail, bool changeHighlighting) const {
+    if (head + tail >= rowCount) {
+        return toString(changeHighlighting);
+    }
+
+    std::string out;
+    out.reserve((head + tail + 9) * getRowBytes());
+    writeHeader(out);
+    writeRows(out, 0, head, changeHighlighting);
+    writeEllipsis(out);
+    writeRows(out, rowCount - tail, rowCount, changeHighlighting);
+    writeFooter(out);
+    return out;
+}
+
+void NumericTable::write(std::ostream& out, bool changeHighlighting) const {
+    // Render a chunk of rows at a time into one reused buffer
+    std::string buffer;
+    buffer.reserve((TABLE_CHUNK_ROWS + 8) * getRowBytes());
+    writeHeader(buffer);
+    for (std::size_t first = 0; first < rowCount; first += TABLE_CHUNK_ROWS) {
+        writeRows(buffer, first, std::min(first + TABLE_CHUNK_ROWS, rowCount), changeHighlighting);
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    writeFooter(buffer);
+    out.write(buffer.data(), buffer.size());
+}
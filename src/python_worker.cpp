@@ -0,0 +1,82 @@
+#include "python_worker.hpp"
+
+#include <stdexcept>
+
+PythonWorker::PythonWorker() {
+    worker = std::thread(&PythonWorker::run, this);
+}
+
+PythonWorker::~PythonWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    worker.join();
+}
+
+void PythonWorker::enqueue(std::function<void()> request) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            throw std::runtime_error("Could not queue request: worker is stopping");
+        }
+        pending.push_back(std::move(request));
+    }
+    ready.notify_one();
+}
+
+std::future<std::unique_ptr<PriceSeries>> PythonWorker::fetchAsync(const std::string& ticker, const std::time_t start, const std::time_t end, const std::string& interval) {
+    return submit([=] {
+        return PriceSeries::getPriceSeries(ticker, start, end, interval);
+    });
+}
+
+std::future<std::unique_ptr<PriceSeries>> PythonWorker::fetchAsync(const std::string& ticker, const std::string& start, const std::string& end, const std::string& interval) {
+    return fetchAsync(ticker, dateStringToEpoch(start), dateStringToEpoch(end), interval);
+}
+
+std::future<void> PythonWorker::plotAsync(std::shared_ptr<const PriceSeries> series, const std::string& savePath, const std::string& type, const bool includeVolume) {
+    PlotSpec spec;
+    spec.type = type;
+    spec.includeVolume = includeVolume;
+    checkJob({series, spec, savePath});
+    return submit([=] {
+        namespace plt = matplotlibcpp;
+        try {
+            series->plot(type, includeVolume, savePath);
+        } catch (...) {
+            plt::close();
+            throw;
+        }
+        plt::close();
+    });
+}
+
+void PythonWorker::run() {
+    PyGILState_STATE gil = PyGILState_Ensure();
+    useAggBackend();
+    PyGILState_Release(gil);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        ready.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            break;
+        }
+        std::vector<std::function<void()>> batch;
+        batch.swap(pending);
+        lock.unlock();
+
+        // One GIL acquisition for the whole batch, failures are stored in
+        // each request's future
+        gil = PyGILState_Ensure();
+        for (auto& request : batch) {
+            request();
+            PyErr_Clear();
+        }
+        PyGILState_Release(gil);
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,270 @@
+#include "render.hpp"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+static void callMethod(PyObject* object, const char* method, PyObject* arg = nullptr) {
+    PyObject* res = arg ? PyObject_CallMethod(object, method, "O", arg) : PyObject_CallMethod(object, method, nullptr);
+    if (!res) {
+        throw std::runtime_error(fmt::format("Call to {}() failed.", method));
+    }
+    Py_DECREF(res);
+}
+
+void checkJob(const RenderJob& job) {
+    if (!job.series || job.series->getCount() <= 0) {
+        throw std::invalid_argument("Could not queue chart: series is empty");
+    }
+    const std::string& type = job.spec.type;
+    if (type != "line" && type != "candlestick" && type != "area") {
+        throw std::invalid_argument("Could not queue chart: plot type " + type + " is not supported");
+    }
+    if (job.spec.width == 0 || job.spec.height == 0 || job.spec.dpi <= 0) {
+        throw std::invalid_argument("Could not queue chart: figure size and dpi must be positive");
+    }
+    if (job.path.empty()) {
+        throw std::invalid_argument("Could not queue chart: path is empty");
+    }
+}
+
+void useAggBackend() {
+    // Headless rendering, switching backend also closes any open figures
+    PyObject* pyplot = PyImport_ImportModule("matplotlib.pyplot");
+    if (pyplot) {
+        PyObject* res = PyObject_CallMethod(pyplot, "switch_backend", "s", "Agg");
+        Py_XDECREF(res);
+        Py_DECREF(pyplot);
+    }
+    PyErr_Clear();
+}
+
+// State of the thread that held the GIL, shared by every InterpreterRelease
+static std::mutex releaseMutex;
+static std::size_t releaseCount = 0;
+static PyThreadState* savedState = nullptr;
+static std::thread::id savedThread;
+
+static void failRelease(const char* reason) {
+    std::cerr << "Could not give back the interpreter: " << reason << std::endl;
+    std::terminate();
+}
+
+InterpreterRelease::InterpreterRelease() : creator(std::this_thread::get_id()) {
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    if (releaseCount++ > 0) {
+        return;
+    }
+    // Start the interpreter here if needed, then release the GIL so
+    // workers can take it
+    matplotlibcpp::detail::_interpreter::get();
+    if (PyGILState_Check()) {
+        savedState = PyEval_SaveThread();
+        savedThread = creator;
+    }
+}
+
+InterpreterRelease::~InterpreterRelease() {
+    const std::thread::id current = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    if (current != creator) {
+        failRelease("released on a different thread than it was taken on");
+    }
+    if (--releaseCount > 0 || !savedState) {
+        return;
+    }
+    if (current != savedThread) {
+        failRelease("the last release must be on the thread that held the GIL");
+    }
+    PyEval_RestoreThread(savedState);
+    savedState = nullptr;
+}
+
+double RenderStats::getChartsPerSecond() const {
+    return seconds > 0.0 ? rendered / seconds : 0.0;
+}
+
+std::string RenderStats::toString() const {
+    std::vector<std::vector<std::string>> tableData = {
+        {"Rendered", fmt::format("{}", rendered)},
+        {"Failed", fmt::format("{}", failed)},
+        {"Seconds", fmt::format("{:.3f}", seconds)},
+        {"Charts/sec", fmt::format("{:.2f}", getChartsPerSecond())}
+    };
+    return getTable("Render Queue", tableData, {12, 12}, {"Metric", "Value"}, false);
+}
+
+RenderQueue::RenderQueue() {
+    worker = std::thread(&RenderQueue::run, this);
+}
+
+RenderQueue::~RenderQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    worker.join();
+}
+
+void RenderQueue::submit(std::shared_ptr<const PriceSeries> series, const PlotSpec& spec, const std::string& path) {
+    submit({RenderJob{std::move(series), spec, path}});
+}
+
+void RenderQueue::submit(const std::vector<RenderJob>& jobs) {
+    for (const auto& job : jobs) {
+        checkJob(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.insert(pending.end(), jobs.begin(), jobs.end());
+    }
+    ready.notify_one();
+}
+
+RenderStats RenderQueue::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return pending.empty() && !busy; });
+    return stats;
+}
+
+RenderStats RenderQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void RenderQueue::run() {
+    PyGILState_STATE gil = PyGILState_Ensure();
+    useAggBackend();
+    PyGILState_Release(gil);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        ready.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            break;
+        }
+        std::vector<RenderJob> batch;
+        batch.swap(pending);
+        busy = true;
+        lock.unlock();
+
+        // One GIL acquisition for the whole batch
+        RenderStats batchStats;
+        auto begin = std::chrono::steady_clock::now();
+        gil = PyGILState_Ensure();
+        for (const auto& job : batch) {
+            try {
+                render(job);
+                ++batchStats.rendered;
+            } catch (const std::exception& e) {
+                PyErr_Clear();
+                ++batchStats.failed;
+                batchStats.errors.push_back(fmt::format("{}: {}", job.path, e.what()));
+            }
+        }
+        PyGILState_Release(gil);
+        batchStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        lock.lock();
+        stats.rendered += batchStats.rendered;
+        stats.failed += batchStats.failed;
+        stats.seconds += batchStats.seconds;
+        stats.errors.insert(stats.errors.end(), batchStats.errors.begin(), batchStats.errors.end());
+        busy = false;
+        idle.notify_all();
+    }
+    lock.unlock();
+
+    gil = PyGILState_Ensure();
+    try {
+        closeFigure();
+    } catch (const std::exception&) {
+        PyErr_Clear();
+    }
+    PyGILState_Release(gil);
+}
+
+void RenderQueue::render(const RenderJob& job) {
+    namespace plt = matplotlibcpp;
+    useFigure(job.spec);
+    std::size_t panelCount = 0;
+    job.series->draw(job.spec.type, job.spec.includeVolume, [&](long row, long rowSpan) {
+        selectPanel(panelCount++, row, rowSpan);
+    });
+    dropPanels(panelCount);
+    plt::tight_layout();
+    plt::save(job.path, job.spec.dpi);
+}
+
+void RenderQueue::useFigure(const PlotSpec& spec) {
+    if (figure && spec.width == figureWidth && spec.height == figureHeight) {
+        return;
+    }
+    closeFigure();
+
+    const auto& interpreter = matplotlibcpp::detail::_interpreter::get();
+    PyObject* size = Py_BuildValue("(dd)", spec.width / 100.0, spec.height / 100.0);
+    PyObject* dpi = PyLong_FromLong(100);
+    PyObject* kwargs = PyDict_New();
+    PyDict_SetItemString(kwargs, "figsize", size);
+    PyDict_SetItemString(kwargs, "dpi", dpi);
+    figure = PyObject_Call(interpreter.s_python_function_figure, interpreter.s_python_empty_tuple, kwargs);
+    Py_DECREF(size);
+    Py_DECREF(dpi);
+    Py_DECREF(kwargs);
+    if (!figure) {
+        throw std::runtime_error("Call to figure() failed.");
+    }
+    figureWidth = spec.width;
+    figureHeight = spec.height;
+}
+
+void RenderQueue::selectPanel(std::size_t index, long row, long rowSpan) {
+    // Same place in the grid as the last chart, clear and reuse the axes
+    if (index < panels.size() && panels[index].row == row && panels[index].rowSpan == rowSpan) {
+        callMethod(panels[index].axes, "cla");
+        callMethod(figure, "sca", panels[index].axes);
+        return;
+    }
+
+    dropPanels(index);
+    matplotlibcpp::subplot2grid(5, 1, row, 0, rowSpan, 1);
+    PyObject* axes = PyObject_CallMethod(figure, "gca", nullptr);
+    if (!axes) {
+        throw std::runtime_error("Call to gca() failed.");
+    }
+    panels.push_back({row, rowSpan, axes});
+}
+
+void RenderQueue::dropPanels(std::size_t count) {
+    while (panels.size() > count) {
+        PyObject* axes = panels.back().axes;
+        panels.pop_back();
+        PyObject* res = PyObject_CallMethod(figure, "delaxes", "O", axes);
+        Py_DECREF(axes);
+        if (!res) {
+            throw std::runtime_error("Call to delaxes() failed.");
+        }
+        Py_DECREF(res);
+    }
+}
+
+void RenderQueue::closeFigure() {
+    if (!figure) {
+        return;
+    }
+    dropPanels(0);
+    PyObject* args = PyTuple_Pack(1, figure);
+    PyObject* res = PyObject_CallObject(matplotlibcpp::detail::_interpreter::get().s_python_function_close, args);
+    Py_DECREF(args);
+    Py_XDECREF(res);
+    Py_DECREF(figure);
+    figure = nullptr;
+    if (!res) {
+        throw std::runtime_error("Call to close() failed.");
+    }
+}
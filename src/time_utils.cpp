@@ -1,54 +1,197 @@
 #include "time_utils.hpp"
 
-std::string epochToDateString(const std::time_t date, bool includeTime) {
-    std::tm* tm = std::localtime(&date);
-    if (tm == nullptr) {
-        return "Invalid time";
+#include <cctype>
+
+// Civil dates -----------------------------------------------------------------
+std::time_t getUTCOffset() {
+    // Compare January 1st this year in UTC with mktime's standard time
+    static const std::time_t offset = [] {
+        std::time_t now = std::time(nullptr);
+        int year = civilFromDays(now / DAY_DURATION).year;
+        std::tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mday = 1;
+        tm.tm_isdst = 0;
+        std::time_t local = std::mktime(&tm);
+        return local == -1 ? 0 : daysFromCivil(year, 1, 1) * DAY_DURATION - local;
+    }();
+    return offset;
+}
+
+static void writeDigits(char* out, std::int64_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
     }
-    std::ostringstream oss;
+}
+
+// Write YYYY-MM-DD and optionally HH:MM:SS of local seconds since 1970
+static CivilDate formatDate(std::time_t local, char* out, bool includeTime) {
+    std::time_t days = local / DAY_DURATION - (local % DAY_DURATION < 0);
+    std::time_t seconds = local - days * DAY_DURATION;
+    CivilDate date = civilFromDays(days);
+    writeDigits(out, date.year, 4);
+    out[4] = '-';
+    writeDigits(out + 5, date.month, 2);
+    out[7] = '-';
+    writeDigits(out + 8, date.day, 2);
     if (includeTime) {
-        oss << std::put_time(tm, "%Y-%m-%d %H:%M:%S");
-    } else {
-        oss << std::put_time(tm, "%Y-%m-%d");
+        out[10] = ' ';
+        writeDigits(out + 11, seconds / HOUR_DURATION, 2);
+        out[13] = ':';
+        writeDigits(out + 14, seconds % HOUR_DURATION / MINUTE_DURATION, 2);
+        out[16] = ':';
+        writeDigits(out + 17, seconds % MINUTE_DURATION, 2);
     }
-    return oss.str();
+    return date;
 }
 
-std::time_t dateStringToEpoch(const std::string& dateStr) {
-    // TODO: Use fmt
-    std::tm tm = {};
-    std::istringstream ss(dateStr);
+// Read YYYY-MM-DD after any leading spaces, the year taking up to four
+// digits and the month and day up to two as std::get_time does. Anything
+// after the day is ignored.
+static bool parseDate(std::string_view text, std::time_t& date) {
+    std::size_t i = 0;
+    while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i]))) {
+        ++i;
+    }
+    auto readNumber = [&](int maxDigits, int& value) {
+        int digits = 0;
+        value = 0;
+        while (i < text.size() && digits < maxDigits && std::isdigit(static_cast<unsigned char>(text[i]))) {
+            value = value * 10 + (text[i++] - '0');
+            ++digits;
+        }
+        return digits > 0;
+    };
+    auto readDash = [&] {
+        return i < text.size() && text[i++] == '-';
+    };
+
+    int year, month, day;
+    if (!readNumber(4, year) || !readDash() || !readNumber(2, month) || !readDash() || !readNumber(2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    date = daysFromCivil(year, month, day) * DAY_DURATION - getUTCOffset();
+    return true;
+}
+
+void formatDates(const std::time_t* dates, std::size_t count, char* out, bool includeTime) {
+    const std::time_t offset = getUTCOffset();
+    const std::size_t length = includeTime ? DATETIME_LENGTH : DATE_LENGTH;
+    for (std::size_t i = 0; i < count; ++i) {
+        formatDate(dates[i] + offset, out + i * length, includeTime);
+    }
+}
+
+std::size_t parseDates(const std::string* dates, std::size_t count, std::time_t* out) {
+    std::size_t failures = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!parseDate(dates[i], out[i])) {
+            out[i] = -1;
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+void wallClockToEpoch(const std::time_t* wallClock, std::size_t count, std::time_t* out) {
+    const std::time_t offset = getUTCOffset();
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = wallClock[i] - offset;
+    }
+}
+
+std::string epochToDateString(const std::time_t date, bool includeTime) {
+    char text[DATETIME_LENGTH];
+    CivilDate civil = formatDate(date + getUTCOffset(), text, includeTime);
+    if (civil.year < 0 || civil.year > 9999) {
+        return "Invalid time";
+    }
+    return std::string(text, includeTime ? DATETIME_LENGTH : DATE_LENGTH);
+}
 
-    ss >> std::get_time(&tm, "%Y-%m-%d");
-    if (ss.fail()) {
+std::time_t dateStringToEpoch(const std::string& dateStr) {
+    std::time_t date;
+    if (!parseDate(dateStr, date)) {
         std::cerr << "Failed to parse date string " << dateStr << std::endl;
         return -1;
     }
+    return date;
+}
 
-    std::time_t time = std::mktime(&tm);
-    if (time == -1) {
-        std::cerr << "Error creating time_t object" << std::endl;
-        return -1;
+// Bar intervals ---------------------------------------------------------------
+static std::int64_t floorDivide(std::int64_t a, std::int64_t b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+std::string Interval::toString() const {
+    switch (unit) {
+        case Unit::MINUTE: return std::to_string(count) + "m";
+        case Unit::HOUR: return std::to_string(count) + "h";
+        case Unit::DAY: return std::to_string(count) + "d";
+        case Unit::WEEK: return std::to_string(count) + "wk";
+        case Unit::MONTH: return std::to_string(count) + "mo";
+        case Unit::YEAR: return std::to_string(count) + "y";
+    }
+    return "";
+}
+
+std::time_t Interval::getBucketStart(std::time_t date, int bucketsAhead) const {
+    const std::time_t offset = getUTCOffset();
+    const std::time_t local = date + offset;
+    std::int64_t days = floorDivide(local, DAY_DURATION);
+    switch (unit) {
+        case Unit::MINUTE:
+        case Unit::HOUR:
+        case Unit::DAY: {
+            const std::time_t length = getSeconds();
+            return (floorDivide(local, length) + bucketsAhead) * length - offset;
+        }
+        case Unit::WEEK: {
+            // 1970-01-01 was a Thursday, so Mondays fall 3 days after a
+            // multiple of 7 days before it
+            const std::int64_t length = 7 * count;
+            days = (floorDivide(days + 3, length) + bucketsAhead) * length - 3;
+            break;
+        }
+        case Unit::MONTH: {
+            const CivilDate civil = civilFromDays(days);
+            std::int64_t months = static_cast<std::int64_t>(civil.year) * 12 + civil.month - 1;
+            months = (floorDivide(months, count) + bucketsAhead) * count;
+            const std::int64_t year = floorDivide(months, 12);
+            days = daysFromCivil(static_cast<int>(year), static_cast<int>(months - year * 12 + 1), 1);
+            break;
+        }
+        case Unit::YEAR: {
+            const std::int64_t year = (floorDivide(civilFromDays(days).year, count) + bucketsAhead) * count;
+            days = daysFromCivil(static_cast<int>(year), 1, 1);
+            break;
+        }
     }
-    return time;
+    return days * DAY_DURATION - offset;
+}
+
+std::time_t getMedianSpacing(const std::time_t* dates, std::size_t count) {
+    if (count < 2) {
+        return DAY_INTERVAL.getSeconds();
+    }
+    std::vector<std::time_t> gaps(count - 1);
+    for (std::size_t i = 1; i < count; ++i) {
+        gaps[i - 1] = dates[i] - dates[i - 1];
+    }
+    auto middle = gaps.begin() + gaps.size() / 2;
+    std::nth_element(gaps.begin(), middle, gaps.end());
+    return *middle;
 }
 
 std::time_t intervalToSeconds(const std::string& interval) {
-    if (interval == "1m") {
-        return MINUTE_DURATION;
-    } else if (interval == "1h") {
-        return HOUR_DURATION;
-    } else if (interval == "1d") {
-        return DAY_DURATION;
-    } else if (interval == "1wk") {
-        return WEEK_DURATION;
-    } else if (interval == "1mo") {
-        return MONTH_DURATION;
-    } else if (interval == "1y") {
-        return YEAR_DURATION;
-    } else {
+    if (isInvalidInterval(interval)) {
         return -1;
     }
+    return Interval::fromString(interval).getSeconds();
 }
 
 bool isInvalidInterval(const std::string& interval) {
@@ -64,7 +207,11 @@ std::tuple<std::vector<std::time_t>, std::vector<std::string>> getTicks(std::tim
     std::time_t interval = (end - start) / (nTicks-1);
     for (int i = 0; i < nTicks; ++i) {
         ticks.push_back(start + i*interval);
-        labels.push_back(epochToDateString(start + i*interval));
+    }
+    std::string text(ticks.size() * DATE_LENGTH, ' ');
+    formatDates(ticks.data(), ticks.size(), text.data());
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        labels.push_back(text.substr(i * DATE_LENGTH, DATE_LENGTH));
     }
     return std::make_tuple(ticks, labels);
 }
\ No newline at end of file
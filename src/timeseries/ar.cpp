@@ -12,22 +12,32 @@ AR::AR(const TimeSeries<double>& data) {
     this->mae = 0.0;
 }
 
-double getNLLAR(const std::vector<double>& params, const std::vector<double>& data) {
+AR::AR(const ModelRecord& record) {
+    this->restore(record);
+    this->arOrder = record.fit.phis.size();
+    this->phis = record.fit.phis;
+    this->name = fmt::format("AR({}) Model", this->arOrder);
+}
+
+double getNLLAR(const double* params, const SeriesView& series, FitWorkspace& workspace) {
     double mu = params[0]; // Mean
-    size_t count = data.size();
-    size_t p = params.size() - 1; // AR order
-    std::vector<double> residuals;
-    double sumSqResiduals = 0.0;
+    const double* data = series.data;
+    size_t count = series.count;
+    int p = series.p; // AR order
+    double* residuals = workspace.residuals.data();
+
+    // Reverse coefficients so phi_j lines up with X_{t-j} in the window [t-p, t)
+    double* lags = workspace.arLags.data();
+    for (int j = 0; j < p; ++j) {
+        lags[p - j - 1] = params[j + 1];
+    }
 
     // Calculate predictions and residuals with current parameters 
+    double sumSqResiduals = 0.0;
     for (size_t i = p; i < count; ++i) {
-        double prediction = mu;
-        for (size_t j = 0; j < p; ++j) {
-            prediction += params[j + 1] * data[i - j - 1];
-        }
-        double residual = data[i] - prediction;
-        residuals.push_back(residual);
-        sumSqResiduals += residual * residual;
+        double prediction = mu + lagDot(lags, data + i - p, p);
+        residuals[i] = data[i] - prediction;
+        sumSqResiduals += residuals[i] * residuals[i];
     }
 
     // Get NLL
@@ -37,79 +47,224 @@ double getNLLAR(const std::vector<double>& params, const std::vector<double>& da
 
 // Wrapper for NLOpt
 double objFunctionAR(const std::vector<double>& x, std::vector<double>& grad, void *data) {
-    std::vector<double>* dataPtr = static_cast<std::vector<double>*>(data);
-    return getNLLAR(x, *dataPtr);
+    ObjectiveData* objective = static_cast<ObjectiveData*>(data);
+    return getNLLAR(x.data(), objective->series, *objective->workspace);
 }
 
-void AR::train(int arOrder) {
-    this->arOrder = arOrder;
+ModelFit fitAR(const double* data, size_t count, int arOrder, FitWorkspace& workspace, const ModelFit* warmStart) {
+    nlopt::opt& optimizer = workspace.getOptimizer(arOrder + 1, 1e-7, 20000);
+    SeriesView series = {data, count, arOrder, 0};
+    workspace.reserve(count, arOrder, 0);
 
-    nlopt::opt optimizer(nlopt::LN_COBYLA, arOrder + 1);
-    optimizer.set_xtol_rel(1e-7);
-    optimizer.set_maxeval(20000);
-
-    // Get price vector
-    std::vector<double> dataVec;
-    for (const auto& [date, value] : this->data) {
-        dataVec.push_back(value);
+    std::vector<double>& x = workspace.x;
+    if (warmStart) {
+        warmStart->getParams(x);
+        if (x.size() != static_cast<size_t>(arOrder + 1)) {
+            throw std::invalid_argument("Could not fit AR model: warm start has the wrong order");
+        }
+    } else {
+        double sampleMean = std::accumulate(data, data + count, 0.0) / count;
+        x.assign(arOrder + 1, 0.1);
+        x[0] = sampleMean;  // Initialize constant parameter to sample mean
     }
 
-    double sampleMean = std::accumulate(dataVec.begin(), dataVec.end(), 0.0) / dataVec.size();
-    std::vector<double> x(arOrder + 1, 0.1);
-    x[0] = sampleMean;  // Initialize constant parameter to sample mean
-    double minNLL;
-
+    ModelFit fit;
     try {
-        optimizer.set_min_objective(objFunctionAR, &dataVec);
-        optimizer.optimize(x, minNLL);
+        ObjectiveData objective = {series, &workspace};
+        optimizer.set_min_objective(objFunctionAR, &objective);
+        optimizer.optimize(x, fit.nll);
     } catch (const std::exception &e) {
         std::cerr << "nlopt failed: " << e.what() << std::endl;
     }
 
     // Save learnt parameters
-    this->c = x[0];
-    this->phis.clear();
-    for (int i = 1; i < arOrder + 1; ++i) {
-        this->phis.push_back(x[i]);
-    }
-
-    // Get accuracy metrics 
-    Eigen::VectorXd labels(this->count - arOrder);
-    Eigen::VectorXd predictions(this->count - arOrder);
-    for (size_t i = arOrder; i < this->count; ++i) {
-        labels(i - arOrder) = dataVec[i];
-        double prediction = this->c;
-        for (int j = 0; j < arOrder; ++j) {
-            prediction += this->phis[j] * dataVec[i - j - 1];
-        }
-        predictions(i - arOrder) = prediction;
+    fit.c = x[0];
+    fit.phis.assign(x.begin() + 1, x.end());
+
+    // Get accuracy metrics from residuals of the learnt parameters
+    getNLLAR(x.data(), series, workspace);
+    double sumSq = 0.0;
+    double sumAbs = 0.0;
+    for (size_t i = arOrder; i < count; ++i) {
+        const double residual = workspace.residuals[i];
+        sumSq += residual * residual;
+        sumAbs += std::abs(residual);
     }
-    this->mse = (labels - predictions).squaredNorm() / (this->count - arOrder);
-    this->rmse = std::sqrt(this->mse);
-    this->mae = (labels - predictions).cwiseAbs().sum() / (this->count - arOrder);
+    fit.mse = sumSq / (count - arOrder);
+    fit.rmse = std::sqrt(fit.mse);
+    fit.mae = sumAbs / (count - arOrder);
+
+    return fit;
+}
+
+void AR::train(int arOrder) {
+    this->arOrder = arOrder;
+
+    // Get price vector
+    std::vector<double> dataVec;
+    for (const auto& [date, value] : this->data) {
+        dataVec.push_back(value);
+    }
+
+    FitWorkspace workspace;
+    ModelFit fit = fitAR(dataVec.data(), dataVec.size(), arOrder, workspace);
+
+    // Save learnt parameters and metrics
+    this->c = fit.c;
+    this->phis = fit.phis;
+    this->mse = fit.mse;
+    this->rmse = fit.rmse;
+    this->mae = fit.mae;
+    this->residuals = workspace.residuals;
+    this->state.reset(fit, dataVec.data(), this->residuals.data(), dataVec.size(), this->data.rbegin()->first);
 
     // Set new name 
     this->name = fmt::format("AR({}) Model", arOrder);
 }
 
-void AR::forecast(int steps) {
-    this->forecasted.clear();
-    std::time_t startDate = this->data.rbegin()->first + intervalToSeconds("1d");
+// Online updating -------------------------------------------------------------
+// Regressor [1, X_t, ..., X_{t-p+1}] for predicting the value after the last
+// observation
+Eigen::VectorXd AR::getRegressor() const {
+    Eigen::VectorXd z(this->arOrder + 1);
+    z(0) = 1.0;
+    for (int j = 0; j < this->arOrder; ++j) {
+        z(j + 1) = this->state.values.getLag(j + 1);
+    }
+    return z;
+}
+
+void AR::enableOnline(double forgettingFactor) {
+    if (this->arOrder < 0) {
+        throw std::runtime_error("Could not enable online updates: AR model must be trained first");
+    }
+    if (this->count <= static_cast<size_t>(this->arOrder)) {
+        throw std::runtime_error("Could not enable online updates: AR model has no training history");
+    }
+    if (forgettingFactor <= 0 || forgettingFactor > 1) {
+        throw std::invalid_argument("Could not enable online updates: forgetting factor must be in (0, 1]");
+    }
+    this->online = true;
+    this->forgettingFactor = forgettingFactor;
+    this->historyWindow = this->count;
 
     std::vector<double> dataVec;
     for (const auto& [date, value] : this->data) {
         dataVec.push_back(value);
     }
 
-    for (int i = 0; i < steps; ++i) {
-        double prediction = this->c;
-        // Add weighted sum of past values
+    // Weighted Gram matrix and moments of the training regressors, the newest 
+    // observation has weight 1 and older ones decay by the forgetting factor
+    int k = this->arOrder + 1;
+    Eigen::MatrixXd gram = Eigen::MatrixXd::Zero(k, k);
+    Eigen::VectorXd moments = Eigen::VectorXd::Zero(k);
+    Eigen::VectorXd z(k);
+    double weight = 1.0;
+    for (size_t t = this->count; t-- > static_cast<size_t>(this->arOrder);) {
+        z(0) = 1.0;
+        for (int j = 0; j < this->arOrder; ++j) {
+            z(j + 1) = dataVec[t - j - 1];
+        }
+        gram.noalias() += weight * z * z.transpose();
+        moments += weight * dataVec[t] * z;
+        weight *= forgettingFactor;
+    }
+
+    // Anchor the recursion at the exact least squares solution, which is the 
+    // conditional MLE the optimizer approximates. Degenerate training data
+    // falls back to the trained parameters with a diffuse covariance.
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(gram);
+    if (ldlt.info() == Eigen::Success && ldlt.rcond() > 1e-12) {
+        this->rlsParams = ldlt.solve(moments);
+        this->rlsCovariance = ldlt.solve(Eigen::MatrixXd::Identity(k, k));
+    } else {
+        this->rlsParams.resize(k);
+        this->rlsParams(0) = this->c;
         for (int j = 0; j < this->arOrder; ++j) {
-            prediction += this->phis[j] * dataVec[dataVec.size() - j - 1];
+            this->rlsParams(j + 1) = this->phis[j];
         }
-        this->forecasted[startDate + i * intervalToSeconds("1d")] = prediction;
-        dataVec.push_back(prediction);
+        this->rlsCovariance = 1e6 * Eigen::MatrixXd::Identity(k, k);
+    }
+
+    this->c = this->rlsParams(0);
+    for (int j = 0; j < this->arOrder; ++j) {
+        this->phis[j] = this->rlsParams(j + 1);
+    }
+    this->errorCount = this->count - this->arOrder;
+
+    // Refresh residuals for the re-anchored parameters
+    FitWorkspace workspace;
+    computeResiduals(ModelType::AR, getFit(), {dataVec.data(), dataVec.size(), this->arOrder, 0}, workspace);
+    this->residuals = workspace.residuals;
+    this->state.reset(getFit(), dataVec.data(), this->residuals.data(), dataVec.size(), this->data.rbegin()->first);
+}
+
+void AR::update(std::time_t date, double value) {
+    if (!this->online) {
+        throw std::runtime_error("Could not update AR model: online updates are not enabled");
+    }
+    if (date <= this->state.lastDate) {
+        throw std::invalid_argument("Could not update AR model: date must be after the last observation");
     }
+
+    // Error of the one-step forecast made before seeing the new value
+    Eigen::VectorXd z = getRegressor();
+    double error = value - this->rlsParams.dot(z);
+
+    // RLS update, O(p^2) in the model order
+    Eigen::VectorXd pz = this->rlsCovariance * z;
+    Eigen::VectorXd gain = pz / (this->forgettingFactor + z.dot(pz));
+    this->rlsParams += gain * error;
+    this->rlsCovariance = (this->rlsCovariance - gain * pz.transpose()) / this->forgettingFactor;
+
+    this->c = this->rlsParams(0);
+    for (int j = 0; j < this->arOrder; ++j) {
+        this->phis[j] = this->rlsParams(j + 1);
+    }
+
+    // Running metrics over all one-step errors seen so far
+    double n = static_cast<double>(this->errorCount);
+    this->mse = (this->mse * n + error * error) / (n + 1);
+    this->mae = (this->mae * n + std::abs(error)) / (n + 1);
+    this->rmse = std::sqrt(this->mse);
+    this->errorCount++;
+
+    // Bounded history, trimmed back to the window once it doubles so each
+    // update costs amortized O(1) on top of the RLS step
+    this->data.emplace_hint(this->data.end(), date, value);
+    this->residuals.push_back(error);
+    if (this->data.size() >= 2 * this->historyWindow) {
+        const std::size_t excess = this->data.size() - this->historyWindow;
+        this->data.erase(this->data.begin(), std::next(this->data.begin(), excess));
+        this->residuals.erase(this->residuals.begin(), this->residuals.begin() + excess);
+    }
+    this->count = this->data.size();
+    this->state.setCoefficients(this->c, this->phis, {});
+    this->state.push(date, value, error);
+}
+
+double AR::getOneStepForecast() const {
+    double prediction;
+    this->state.forecast(1, &prediction);
+    return prediction;
+}
+
+bool AR::isOnline() const {
+    return this->online;
+}
+
+ModelRecord AR::getRecord() const {
+    return this->makeRecord(ModelType::AR);
+}
+
+ModelFit AR::getFit() const {
+    ModelFit fit;
+    fit.c = this->c;
+    fit.phis = this->phis;
+    fit.mse = this->mse;
+    fit.rmse = this->rmse;
+    fit.mae = this->mae;
+    return fit;
 }
 
 std::vector<double> AR::getPhis() const {
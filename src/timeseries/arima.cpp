@@ -0,0 +1,180 @@
+#include "timeseries/timeseries_models.hpp"
+
+ARIMA::ARIMA(const TimeSeries<double>& data) {
+    this->data = data;
+    this->count = data.size();
+    this->name = "ARIMA Model (Untrained)";
+
+    // Mark model as untrained
+    this->arOrder = -1;
+    this->diffOrder = -1;
+    this->maOrder = -1;
+
+    this->c = 0;
+
+    this->mse = 0;
+    this->rmse = 0;
+    this->mae = 0;
+}
+
+void ARIMA::train(int arOrder, int diffOrder, int maOrder) {
+    if (arOrder < 0 || diffOrder < 0 || maOrder < 0) {
+        throw std::invalid_argument("Could not train ARIMA model: orders must be non-negative");
+    }
+    if (this->count <= static_cast<size_t>(diffOrder + std::max(arOrder, maOrder))) {
+        throw std::invalid_argument("Could not train ARIMA model: not enough data for the requested orders");
+    }
+    this->arOrder = arOrder;
+    this->diffOrder = diffOrder;
+    this->maOrder = maOrder;
+
+    // Copy the data out of the map once and difference it in place
+    this->differenced.clear();
+    this->differenced.reserve(this->count);
+    for (const auto& [date, value] : this->data) {
+        this->differenced.push_back(value);
+    }
+    this->tails.resize(diffOrder);
+    differenceInPlace(this->differenced.data(), this->count, diffOrder, this->tails.data());
+    const double* series = this->differenced.data() + diffOrder;
+    const size_t seriesCount = this->count - diffOrder;
+
+    FitWorkspace workspace;
+    ModelFit fit = fitARMA(series, seriesCount, arOrder, maOrder, workspace);
+
+    // Save learnt parameters and metrics, one-step errors of the differences
+    // equal those of the levels
+    this->c = fit.c;
+    this->phis = fit.phis;
+    this->thetas = fit.thetas;
+    this->mse = fit.mse;
+    this->rmse = fit.rmse;
+    this->mae = fit.mae;
+
+    // Residuals aligned with data, none for the values lost to differencing
+    this->residuals.assign(diffOrder, 0.0);
+    this->residuals.insert(this->residuals.end(), workspace.residuals.begin(), workspace.residuals.end());
+    this->state.reset(fit, series, workspace.residuals.data(), seriesCount, this->data.rbegin()->first);
+
+    // Set new name
+    this->name = fmt::format("ARIMA({}, {}, {}) Model", arOrder, diffOrder, maOrder);
+}
+
+void ARIMA::forecast(int steps, double* out) const {
+    // Forecast the differences and integrate them onto the last levels
+    this->state.forecast(steps, out);
+    integrateInPlace(out, steps, this->diffOrder, this->tails.data());
+}
+
+ForecastResult ARIMA::forecastIntervals(const std::vector<int>& horizons, double level) const {
+    if (!(level > 0.0 && level < 1.0)) {
+        throw std::invalid_argument("Could not forecast: level must be in (0, 1)");
+    }
+    int maxHorizon = 0;
+    for (int h : horizons) {
+        if (h < 1) {
+            throw std::invalid_argument("Could not forecast: horizons must be at least 1");
+        }
+        maxHorizon = std::max(maxHorizon, h);
+    }
+
+    // Integration needs every step up to the largest horizon
+    std::vector<double> path(maxHorizon);
+    forecast(maxHorizon, path.data());
+
+    // Psi-weights of the integrated process are the ARMA weights summed d times
+    std::vector<double> psi(maxHorizon);
+    getPsiWeights(this->phis, this->thetas, maxHorizon, psi.data());
+    for (int k = 0; k < this->diffOrder; ++k) {
+        std::partial_sum(psi.begin(), psi.end(), psi.begin());
+    }
+    std::vector<double> sumPsiSq(maxHorizon);
+    double sum = 0.0;
+    for (int j = 0; j < maxHorizon; ++j) {
+        sum += psi[j] * psi[j];
+        sumPsiSq[j] = sum;
+    }
+
+    ForecastResult result;
+    result.horizons = horizons;
+    result.level = level;
+    const double quantile = getNormalQuantile(0.5 + 0.5 * level);
+    for (int h : horizons) {
+        double stdErr = this->rmse * std::sqrt(sumPsiSq[h - 1]);
+        result.mean.push_back(path[h - 1]);
+        result.stdErr.push_back(stdErr);
+        result.lower.push_back(path[h - 1] - quantile * stdErr);
+        result.upper.push_back(path[h - 1] + quantile * stdErr);
+    }
+    return result;
+}
+
+SimulationResult ARIMA::simulate(int steps, const SimulationConfig& config) const {
+    if (this->arOrder < 0) {
+        throw std::runtime_error("Could not simulate paths: model must be trained first");
+    }
+    return simulatePaths(getFit(),
+                         this->differenced.data() + this->diffOrder,
+                         this->residuals.data() + this->diffOrder,
+                         this->count - this->diffOrder,
+                         steps,
+                         config,
+                         this->tails);
+}
+
+size_t ARIMA::getResidualStart() const {
+    return this->diffOrder + std::max(this->arOrder, this->maOrder);
+}
+
+ModelFit ARIMA::getFit() const {
+    ModelFit fit;
+    fit.c = this->c;
+    fit.phis = this->phis;
+    fit.thetas = this->thetas;
+    fit.mse = this->mse;
+    fit.rmse = this->rmse;
+    fit.mae = this->mae;
+    return fit;
+}
+
+std::vector<double> ARIMA::getPhis() const {
+    return this->phis;
+}
+
+std::vector<double> ARIMA::getThetas() const {
+    return this->thetas;
+}
+
+int ARIMA::getDiffOrder() const {
+    return this->diffOrder;
+}
+
+std::string ARIMA::toString() const {
+    auto columnWidths = {12, 12};
+    int totalWidth = std::accumulate(columnWidths.begin(), columnWidths.end(), 0) + columnWidths.size() - 1;
+    auto justifications = {Justification::LEFT, Justification::RIGHT};
+    auto colors = {Color::WHITE, Color::WHITE};
+
+    // Title
+    auto table = getTopLine({totalWidth});
+    table += getRow({this->name}, {totalWidth}, {Justification::CENTER}, {Color::WHITE});
+
+    // Params
+    table += getMidLine({columnWidths}, Ticks::LOWER);
+    for (int i = 0; i < this->arOrder; ++i) {
+        table += getRow({fmt::format("phi_{}", i + 1), fmt::format("{:.4f}", this->phis[i])}, columnWidths, justifications, colors);
+    }
+    for (int i = 0; i < this->maOrder; ++i) {
+        table += getRow({fmt::format("theta_{}", i + 1), fmt::format("{:.4f}", this->thetas[i])}, columnWidths, justifications, colors);
+    }
+    table += getRow({"const", fmt::format("{:.4f}", this->c)}, columnWidths, justifications, colors);
+
+    // Metrics
+    table += getMidLine({columnWidths}, Ticks::BOTH);
+    table += getRow({"MSE", fmt::format("{:.4f}", this->mse)}, columnWidths, justifications, colors);
+    table += getRow({"RMSE", fmt::format("{:.4f}", this->rmse)}, columnWidths, justifications, colors);
+    table += getRow({"MAE", fmt::format("{:.4f}", this->mae)}, columnWidths, justifications, colors);
+    table += getBottomLine(columnWidths);
+
+    return table;
+}
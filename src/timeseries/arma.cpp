@@ -1,11 +1,5 @@
 #include "timeseries/timeseries_models.hpp"
 
-struct ARMAData {
-    std::vector<double> data;
-    int p;
-    int q;
-};
-
 ARMA::ARMA(const TimeSeries<double>& data) {
     this->data = data;
     this->count = data.size();
@@ -22,175 +16,150 @@ ARMA::ARMA(const TimeSeries<double>& data) {
     this->mae = 0;
 }
 
-double getNLLARMA(const std::vector<double>& params, const std::vector<double>& data, int p, int q) {
+ARMA::ARMA(const ModelRecord& record) {
+    this->restore(record);
+    this->arOrder = record.fit.phis.size();
+    this->maOrder = record.fit.thetas.size();
+    this->phis = record.fit.phis;
+    this->thetas = record.fit.thetas;
+    this->name = fmt::format("ARMA({}, {}) Model", this->arOrder, this->maOrder);
+}
+
+double getNLLARMA(const double* params, const SeriesView& series, FitWorkspace& workspace) {
     double mu = params[0];
-    std::vector<double> arCoeffs(params.begin() + 1, params.begin() + p + 2);
-    std::vector<double> maCoeffs(params.begin() + p + 1, params.begin() + p + q + 1);
+    const double* data = series.data;
+    size_t count = series.count;
+    int p = series.p;
+    int q = series.q;
+    int start = std::max(p, q);
+    double* residuals = workspace.residuals.data();
+
+    // Reverse coefficients so lag j lines up with t-j in the windows ending at t
+    double* arLags = workspace.arLags.data();
+    double* maLags = workspace.maLags.data();
+    for (int i = 0; i < p; ++i) {
+        arLags[p - i - 1] = params[i + 1];
+    }
+    for (int i = 0; i < q; ++i) {
+        maLags[q - i - 1] = params[p + i + 1];
+    }
 
-    size_t count = data.size();
-    std::vector<double> residuals(count, 0.0);
+    // Residuals before the first full lag window are taken as zero
+    std::fill(residuals, residuals + start, 0.0);
     double sumResidualsSq = 0.0;
-
-    for (size_t t = std::max(p, q); t < count; ++t) {
-        double arPart = 0.0;
-        double maPart = 0.0;
-
+    for (size_t t = start; t < count; ++t) {
         // X_t = phi_1 * X_{t-1} + ... + phi_p * X_{t-p} + e_t + theta_1 * e_{t-1} + ... + theta_q * e_{t-q}
         // arPart = phi_1 * X_{t-1} + ... + phi_p * X_{t-p}
-        for (int i = 0; i < p; ++i) {
-            arPart += arCoeffs[i] * data[t - 1 - i];
-        }
+        double arPart = lagDot(arLags, data + t - p, p);
 
         // maPart = theta_1 * e_{t-1} + ... + theta_q * e_{t-q}
-        for (int i = 0; i < q; ++i) {
-            maPart += maCoeffs[i] * residuals[t - 1 - i];
-        }
+        double maPart = lagDot(maLags, residuals + t - q, q);
 
         residuals[t] = data[t] - arPart - maPart - mu;
         sumResidualsSq += residuals[t] * residuals[t];
     }
 
-    double sigmaSq = sumResidualsSq / (count - std::max(p, q));
-    double nll = 0.5 * (count - std::max(p, q)) * std::log(2 * M_PI * sigmaSq) + (0.5 / sigmaSq) * sumResidualsSq;
+    double sigmaSq = sumResidualsSq / (count - start);
+    double nll = 0.5 * (count - start) * std::log(2 * M_PI * sigmaSq) + (0.5 / sigmaSq) * sumResidualsSq;
     return nll;
 }
 
 double objFunctionARMA(const std::vector<double>& x, std::vector<double>& grad, void *data) {
-    ARMAData* modelData = static_cast<ARMAData*>(data);
-    return getNLLARMA(x, modelData->data, modelData->p, modelData->q);
+    ObjectiveData* objective = static_cast<ObjectiveData*>(data);
+    return getNLLARMA(x.data(), objective->series, *objective->workspace);
 }
 
-void ARMA::train(int arOrder, int maOrder) {
-    this->arOrder = arOrder;
-    this->maOrder = maOrder;
-
+ModelFit fitARMA(const double* data, size_t count, int arOrder, int maOrder, FitWorkspace& workspace, const ModelFit* warmStart) {
     int paramCount = arOrder + maOrder + 1; // Include AR, MA params and mean
-    nlopt::opt optimizer(nlopt::LN_COBYLA, paramCount);
-    optimizer.set_xtol_rel(1e-6);
-    optimizer.set_maxeval(10000);
-
-    // Construct data vector
-    std::vector<double> dataVec;
-    for (const auto& [date, value] : this->data) {
-        dataVec.push_back(value);
+    nlopt::opt& optimizer = workspace.getOptimizer(paramCount, 1e-6, 10000);
+    SeriesView series = {data, count, arOrder, maOrder};
+    workspace.reserve(count, arOrder, maOrder);
+
+    std::vector<double>& x = workspace.x;
+    if (warmStart) {
+        warmStart->getParams(x);
+        if (x.size() != static_cast<size_t>(paramCount)) {
+            throw std::invalid_argument("Could not fit ARMA model: warm start has the wrong orders");
+        }
+    } else {
+        // Set initial mean param to empirical mean
+        x.assign(paramCount, 0.1);
+        x[0] = std::accumulate(data, data + count, 0.0) / count;
     }
 
-    // Set initial mean param to empirical mean
-    std::vector<double> x(paramCount, 0.1);
-    x[0] = std::accumulate(dataVec.begin(), dataVec.end(), 0.0) / dataVec.size();
-    double minNLL;
-
+    ModelFit fit;
     try {
-        // Data wrapper to pass model order to objective function
-        ARMAData armaData = {dataVec, arOrder, maOrder};
-        optimizer.set_min_objective(objFunctionARMA, &armaData);
-        optimizer.optimize(x, minNLL);
+        // Data wrapper to pass model order and workspace to objective function
+        ObjectiveData objective = {series, &workspace};
+        optimizer.set_min_objective(objFunctionARMA, &objective);
+        optimizer.optimize(x, fit.nll);
     } catch (const std::exception &e) {
         std::cerr << "nlopt failed: " << e.what() << std::endl;
     }
 
     // Save learnt parameters
-    this->c = x[0];
-    this->phis.clear();
-    for (int i = 1; i < this->arOrder+1; ++i) {
-        this->phis.push_back(x[i]);
-    }
-    this->thetas.clear();
-    for (int i = 1; i < this->maOrder+1; ++i) {
-        this->thetas.push_back(x[i+this->arOrder]);
+    fit.c = x[0];
+    fit.phis.assign(x.begin() + 1, x.begin() + 1 + arOrder);
+    fit.thetas.assign(x.begin() + 1 + arOrder, x.end());
+
+    // Set metrics from one-step residuals of the learnt parameters on the
+    // training data
+    getNLLARMA(x.data(), series, workspace);
+    size_t start = std::max(arOrder, maOrder);
+    double sumSq = 0.0;
+    double sumAbs = 0.0;
+    for (size_t t = start; t < count; ++t) {
+        const double residual = workspace.residuals[t];
+        sumSq += residual * residual;
+        sumAbs += std::abs(residual);
     }
+    fit.mse = sumSq / (count - start);
+    fit.rmse = std::sqrt(fit.mse);
+    fit.mae = sumAbs / (count - start);
 
-    // Set new name
-    this->name = fmt::format("ARMA({}, {}) Model", arOrder, maOrder);
-
-    // Set metrics 
-    // First maOrder residuals are simple
-    std::vector<double> residuals;
-    for (int i = 0; i < maOrder; ++i) {
-        residuals.push_back(dataVec[i] - this->c);
-    }
-
-    // Make predictions on training data
-    Eigen::VectorXd labels(this->count - std::max(arOrder, maOrder));
-    Eigen::VectorXd predictions(this->count - std::max(arOrder, maOrder));
-    for (size_t i = std::max(arOrder, maOrder); i < this->count; ++i) {
-        labels(i - std::max(arOrder, maOrder)) = dataVec[i];
-        double prediction = this->c;
-        for (int j = 0; j < arOrder; ++j) {
-            prediction += this->phis[j] * dataVec[dataVec.size() - j - 1];
-        }
-        for (int j = 0; j < maOrder; ++j) {
-            prediction += this->thetas[j] * residuals[residuals.size() - j - 1];
-        }
-        predictions(i - std::max(arOrder, maOrder)) = prediction;
-        dataVec.push_back(prediction);
-        residuals.push_back(dataVec[i] - prediction);
-    }
-
-    this->mse = (labels - predictions).squaredNorm() / (this->count - std::max(arOrder, maOrder));
-    this->rmse = std::sqrt(this->mse);
-    this->mae = (labels - predictions).cwiseAbs().sum() / (this->count - std::max(arOrder, maOrder));
+    return fit;
 }
 
-void ARMA::forecast(int steps) {
-    this->forecasted.clear();
-    int p = this->arOrder;
-    int q = this->maOrder;
-    size_t count = this->count;
-
-    std::vector<double> residuals(count);
-
-    // Starting date for predictions
-    std::time_t startDate = this->data.rbegin()->first + intervalToSeconds("1d");
+void ARMA::train(int arOrder, int maOrder) {
+    this->arOrder = arOrder;
+    this->maOrder = maOrder;
 
-    // Construct data vector from historical data
+    // Construct data vector
     std::vector<double> dataVec;
     for (const auto& [date, value] : this->data) {
         dataVec.push_back(value);
     }
 
-    // Get residuals for current learned parameters
-    for (int t = std::max(p, q); t < count; ++t) {
-        double arPart = 0.0;
-        double maPart = 0.0;
-
-        // AR part: phi_1 * X_{t-1} + ... + phi_p * X_{t-p}
-        for (int i = 0; i < p; ++i) {
-            arPart += this->phis[i] * dataVec[t - i - 1];
-        }
-
-        // MA part: theta_1 * e_{t-1} + ... + theta_q * e_{t-q}
-        for (int i = 0; i < q; ++i) {
-            maPart += this->thetas[i] * residuals[t - i - 1];
-        }
+    FitWorkspace workspace;
+    ModelFit fit = fitARMA(dataVec.data(), dataVec.size(), arOrder, maOrder, workspace);
 
-        double prediction = arPart + maPart + this->c;
-        residuals[t] = dataVec[t] - prediction;
-    }
-
-    // Forecast future values
-    for (int i = 0; i < steps; ++i) {
-        double forecast = this->c;
-        double arPart = 0.0;
-        double maPart = 0.0;
+    // Save learnt parameters and metrics
+    this->c = fit.c;
+    this->phis = fit.phis;
+    this->thetas = fit.thetas;
+    this->mse = fit.mse;
+    this->rmse = fit.rmse;
+    this->mae = fit.mae;
+    this->residuals = workspace.residuals;
+    this->state.reset(fit, dataVec.data(), this->residuals.data(), dataVec.size(), this->data.rbegin()->first);
 
-        // AR part
-        for (int j = 0; j < p; ++j) {
-            arPart += this->phis[j] * dataVec[count + i - j - 1]; 
-        }
+    // Set new name
+    this->name = fmt::format("ARMA({}, {}) Model", arOrder, maOrder);
+}
 
-        // MA part: Bootstrap residuals from past residuals
-        double sampledResidual = residuals[rand() % count];
-        for (int k = 0; k < q; ++k) {
-            maPart += this->thetas[k] * residuals[count + i - k - 1]; 
-        }
+ModelRecord ARMA::getRecord() const {
+    return this->makeRecord(ModelType::ARMA);
+}
 
-        forecast += (arPart + maPart);
-        this->forecasted[startDate] = forecast;
-        startDate += intervalToSeconds("1d");
-        dataVec.push_back(forecast);
-        residuals.push_back(sampledResidual);
-    }
+ModelFit ARMA::getFit() const {
+    ModelFit fit;
+    fit.c = this->c;
+    fit.phis = this->phis;
+    fit.thetas = this->thetas;
+    fit.mse = this->mse;
+    fit.rmse = this->rmse;
+    fit.mae = this->mae;
+    return fit;
 }
 
 std::vector<double> ARMA::getPhis() const {
@@ -0,0 +1,198 @@
+#include "timeseries/autocorrelation.hpp"
+#include "timeseries/timeseries_models.hpp"
+#include "thread_utils.hpp"
+#include "print_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+void fft(std::vector<std::complex<double>>& buffer, std::vector<std::complex<double>>& twiddles, bool inverse) {
+    const std::size_t n = buffer.size();
+    if (twiddles.size() != n / 2) {
+        twiddles.resize(n / 2);
+        for (std::size_t k = 0; k < n / 2; ++k) {
+            twiddles[k] = std::polar(1.0, -2 * M_PI * k / n);
+        }
+    }
+
+    // Bit reversal permutation
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(buffer[i], buffer[j]);
+        }
+    }
+
+    // Butterflies, stage lengths 2, 4, ..., n
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+        const std::size_t half = length / 2;
+        const std::size_t stride = n / length;
+        for (std::size_t i = 0; i < n; i += length) {
+            for (std::size_t k = 0; k < half; ++k) {
+                std::complex<double> w = inverse ? std::conj(twiddles[k * stride]) : twiddles[k * stride];
+                std::complex<double> u = buffer[i + k];
+                std::complex<double> v = buffer[i + k + half] * w;
+                buffer[i + k] = u + v;
+                buffer[i + k + half] = u - v;
+            }
+        }
+    }
+}
+
+void getACF(const double* values, std::size_t count, int maxLag, double* out, CorrelationWorkspace& workspace) {
+    if (maxLag < 0 || static_cast<std::size_t>(maxLag) >= count) {
+        throw std::invalid_argument("Could not get ACF: max lag must be non-negative and less than the series length");
+    }
+
+    // Zero pad to a power of two of at least count + maxLag so the circular
+    // correlation equals the linear one for the lags we need
+    std::size_t size = 1;
+    while (size < count + maxLag) {
+        size <<= 1;
+    }
+
+    double mean = std::accumulate(values, values + count, 0.0) / count;
+    double sumSq = 0.0;
+    auto& buffer = workspace.buffer;
+    buffer.assign(size, 0.0);
+    for (std::size_t t = 0; t < count; ++t) {
+        double centred = values[t] - mean;
+        buffer[t] = centred;
+        sumSq += centred * centred;
+    }
+
+    out[0] = 1.0;
+    if (sumSq == 0.0) {
+        std::fill(out + 1, out + maxLag + 1, 0.0);
+        return;
+    }
+
+    // Autocovariances are the inverse transform of the power spectrum
+    fft(buffer, workspace.twiddles, false);
+    for (auto& value : buffer) {
+        value = std::norm(value);
+    }
+    fft(buffer, workspace.twiddles, true);
+
+    const double scale = buffer[0].real();
+    for (int k = 1; k <= maxLag; ++k) {
+        out[k] = buffer[k].real() / scale;
+    }
+}
+
+std::vector<double> getACF(const std::vector<double>& values, int maxLag) {
+    std::vector<double> acf(std::max(maxLag, 0) + 1);
+    CorrelationWorkspace workspace;
+    getACF(values.data(), values.size(), maxLag, acf.data(), workspace);
+    return acf;
+}
+
+void getPACF(const double* acf, int maxLag, double* out) {
+    out[0] = 1.0;
+    if (maxLag == 0) {
+        return;
+    }
+
+    // phi holds the AR(k) coefficients fitted to the autocorrelations
+    std::vector<double> phi(maxLag + 1, 0.0);
+    std::vector<double> previous(maxLag + 1, 0.0);
+    double variance = 1.0;
+    for (int k = 1; k <= maxLag; ++k) {
+        double numerator = acf[k];
+        for (int j = 1; j < k; ++j) {
+            numerator -= previous[j] * acf[k - j];
+        }
+
+        // A perfectly predictable series leaves nothing to explain
+        double reflection = variance > 0.0 ? numerator / variance : 0.0;
+        phi[k] = reflection;
+        for (int j = 1; j < k; ++j) {
+            phi[j] = previous[j] - reflection * previous[k - j];
+        }
+        variance *= 1.0 - reflection * reflection;
+
+        out[k] = reflection;
+        std::copy(phi.begin(), phi.begin() + k + 1, previous.begin());
+    }
+}
+
+std::vector<double> getPACF(const std::vector<double>& acf) {
+    if (acf.empty()) {
+        throw std::invalid_argument("Could not get PACF: autocorrelations must include lag 0");
+    }
+    std::vector<double> pacf(acf.size());
+    getPACF(acf.data(), acf.size() - 1, pacf.data());
+    return pacf;
+}
+
+double CorrelationTable::getBound(std::size_t series, double level) const {
+    return getNormalQuantile(0.5 + 0.5 * level) / std::sqrt(static_cast<double>(counts[series]));
+}
+
+std::string CorrelationTable::toString(std::size_t series) const {
+    if (series >= size()) {
+        throw std::invalid_argument(fmt::format("Could not print correlations: series {} out of range", series));
+    }
+    std::vector<std::string> columnHeaders = {"Lag", "ACF", "PACF"};
+    std::vector<int> columnWidths(columnHeaders.size(), 10);
+
+    // Highlight correlations outside the 95% white noise band
+    const double bound = getBound(series);
+    auto format = [bound](double value) {
+        return fmt::format("{:.4f}{}", value, std::abs(value) > bound ? "*" : "");
+    };
+
+    std::vector<std::vector<std::string>> tableData;
+    for (int k = 1; k <= maxLag; ++k) {
+        tableData.push_back({fmt::format("{}", k), format(getACF(series)[k]), format(getPACF(series)[k])});
+    }
+    return getTable(fmt::format("Correlogram (n = {}, * beyond {:.4f})", counts[series], bound), tableData, columnWidths, columnHeaders, false);
+}
+
+CorrelationTable getCorrelations(const std::vector<std::vector<double>>& series, int maxLag, unsigned threadCount) {
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        if (maxLag < 0 || static_cast<std::size_t>(maxLag) >= series[i].size()) {
+            throw std::invalid_argument(fmt::format("Could not get correlations: series {} is not longer than the max lag", i));
+        }
+    }
+
+    CorrelationTable table;
+    table.maxLag = maxLag;
+    table.acf.resize(series.size() * (maxLag + 1));
+    table.pacf.resize(series.size() * (maxLag + 1));
+    for (const auto& s : series) {
+        table.counts.push_back(s.size());
+    }
+
+    std::vector<CorrelationWorkspace> workspaces(getThreadCount(threadCount));
+    parallelFor(series.size(), threadCount, [&](std::size_t i, unsigned worker) {
+        // Each worker writes disjoint rows
+        double* acf = table.acf.data() + i * (maxLag + 1);
+        double* pacf = table.pacf.data() + i * (maxLag + 1);
+        getACF(series[i].data(), series[i].size(), maxLag, acf, workspaces[worker]);
+        getPACF(acf, maxLag, pacf);
+    });
+
+    return table;
+}
+
+std::vector<double> TimeSeriesModel::getResidualACF(int maxLag) const {
+    if (this->count == 0 || this->residuals.size() != this->count) {
+        throw std::runtime_error("Could not get residual ACF: model must be trained on data first");
+    }
+    std::size_t start = getResidualStart();
+    std::vector<double> acf(std::max(maxLag, 0) + 1);
+    CorrelationWorkspace workspace;
+    getACF(this->residuals.data() + start, this->count - start, maxLag, acf.data(), workspace);
+    return acf;
+}
+
+std::vector<double> TimeSeriesModel::getResidualPACF(int maxLag) const {
+    return getPACF(getResidualACF(maxLag));
+}
@@ -0,0 +1,124 @@
+#include "timeseries/batch.hpp"
+#include "thread_utils.hpp"
+#include "print_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+std::pair<int, int> getModelOrders(ModelType type, int arOrder, int maOrder) {
+    switch (type) {
+        case ModelType::AR: return {arOrder, 0};
+        case ModelType::MA: return {0, maOrder};
+        default:            return {arOrder, maOrder};
+    }
+}
+
+std::string getModelName(ModelType type, int arOrder, int maOrder) {
+    switch (type) {
+        case ModelType::AR: return fmt::format("AR({})", arOrder);
+        case ModelType::MA: return fmt::format("MA({})", maOrder);
+        default:            return fmt::format("ARMA({}, {})", arOrder, maOrder);
+    }
+}
+
+BatchFitTable fitBatch(const std::vector<double>& values,
+                       const std::vector<std::size_t>& offsets,
+                       ModelType type,
+                       int arOrder,
+                       int maOrder,
+                       unsigned threadCount) {
+    auto [p, q] = getModelOrders(type, arOrder, maOrder);
+    if (p < 0 || q < 0) {
+        throw std::invalid_argument("Could not fit batch: model orders must be non-negative");
+    }
+    if (offsets.empty() || offsets.back() > values.size()) {
+        throw std::invalid_argument("Could not fit batch: offsets must end within the values buffer");
+    }
+    std::size_t seriesCount = offsets.size() - 1;
+    for (std::size_t i = 0; i < seriesCount; ++i) {
+        if (offsets[i + 1] < offsets[i]) {
+            throw std::invalid_argument("Could not fit batch: offsets must be non-decreasing");
+        }
+        if (offsets[i + 1] - offsets[i] <= static_cast<std::size_t>(std::max(p, q))) {
+            throw std::invalid_argument(fmt::format("Could not fit batch: series {} is shorter than the model order", i));
+        }
+    }
+
+    BatchFitTable table;
+    table.type = type;
+    table.arOrder = p;
+    table.maOrder = q;
+    table.paramCount = 1 + p + q;
+    table.params.resize(seriesCount * table.paramCount);
+    table.nll.resize(seriesCount);
+    table.mse.resize(seriesCount);
+    table.rmse.resize(seriesCount);
+    table.mae.resize(seriesCount);
+
+    std::vector<FitWorkspace> workspaces(getThreadCount(threadCount));
+    parallelFor(seriesCount, threadCount, [&](std::size_t i, unsigned worker) {
+        const double* data = values.data() + offsets[i];
+        std::size_t count = offsets[i + 1] - offsets[i];
+        FitWorkspace& workspace = workspaces[worker];
+
+        ModelFit fit = fitModel(type, data, count, p, q, workspace);
+
+        // Write row, each worker touches disjoint rows so no locking needed
+        double* row = table.params.data() + i * table.paramCount;
+        row[0] = fit.c;
+        std::copy(fit.phis.begin(), fit.phis.end(), row + 1);
+        std::copy(fit.thetas.begin(), fit.thetas.end(), row + 1 + p);
+        table.nll[i] = fit.nll;
+        table.mse[i] = fit.mse;
+        table.rmse[i] = fit.rmse;
+        table.mae[i] = fit.mae;
+    });
+
+    return table;
+}
+
+BatchFitTable fitBatch(const std::vector<std::vector<double>>& series,
+                       ModelType type,
+                       int arOrder,
+                       int maOrder,
+                       unsigned threadCount) {
+    // Pack series into one contiguous buffer
+    std::vector<std::size_t> offsets = {0};
+    for (const auto& s : series) {
+        offsets.push_back(offsets.back() + s.size());
+    }
+    std::vector<double> values;
+    values.reserve(offsets.back());
+    for (const auto& s : series) {
+        values.insert(values.end(), s.begin(), s.end());
+    }
+    return fitBatch(values, offsets, type, arOrder, maOrder, threadCount);
+}
+
+std::string BatchFitTable::toString() const {
+    std::vector<std::string> columnHeaders = {"Series", "const"};
+    for (int i = 0; i < arOrder; ++i) {
+        columnHeaders.push_back(fmt::format("phi_{}", i + 1));
+    }
+    for (int i = 0; i < maOrder; ++i) {
+        columnHeaders.push_back(fmt::format("theta_{}", i + 1));
+    }
+    columnHeaders.insert(columnHeaders.end(), {"MSE", "RMSE", "MAE"});
+    std::vector<int> columnWidths(columnHeaders.size(), 10);
+
+    std::vector<std::vector<std::string>> tableData;
+    for (std::size_t i = 0; i < size(); ++i) {
+        std::vector<std::string> row = {fmt::format("{}", i)};
+        const double* rowParams = getParams(i);
+        for (std::size_t j = 0; j < paramCount; ++j) {
+            row.push_back(fmt::format("{:.4f}", rowParams[j]));
+        }
+        row.push_back(fmt::format("{:.4f}", mse[i]));
+        row.push_back(fmt::format("{:.4f}", rmse[i]));
+        row.push_back(fmt::format("{:.4f}", mae[i]));
+        tableData.push_back(row);
+    }
+
+    return getTable(fmt::format("Batch {} Fit", getModelName(type, arOrder, maOrder)), tableData, columnWidths, columnHeaders, false);
+}
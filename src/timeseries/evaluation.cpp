@@ -0,0 +1,113 @@
+#include "timeseries/evaluation.hpp"
+#include "thread_utils.hpp"
+#include "print_utils.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+WalkForwardResult walkForward(const std::vector<double>& values,
+                              ModelType type,
+                              int arOrder,
+                              int maOrder,
+                              const WalkForwardConfig& config) {
+    int p = type == ModelType::MA ? 0 : arOrder;
+    int q = type == ModelType::AR ? 0 : maOrder;
+    std::size_t n = values.size();
+    if (p < 0 || q < 0) {
+        throw std::invalid_argument("Could not run walk forward evaluation: model orders must be non-negative");
+    }
+    if (config.horizon < 1 || config.refitEvery < 1 || config.step < 1) {
+        throw std::invalid_argument("Could not run walk forward evaluation: horizon, refit interval and step must be positive");
+    }
+    if (config.initialWindow <= static_cast<std::size_t>(std::max(p, q) + 1) || config.initialWindow >= n) {
+        throw std::invalid_argument("Could not run walk forward evaluation: initial window must exceed the model order and leave data to forecast");
+    }
+
+    WalkForwardResult result;
+    for (std::size_t origin = config.initialWindow; origin < n; origin += config.step) {
+        result.origins.push_back(origin);
+    }
+    std::size_t originCount = result.origins.size();
+    const std::size_t horizon = config.horizon;
+    result.forecasts.resize(originCount * horizon);
+
+    // Contiguous blocks of origins, refits only warm-start within a block so
+    // blocks are independent. Block boundaries land on refit points.
+    unsigned threadCount = getThreadCount(config.threadCount);
+    std::size_t refitCount = (originCount + config.refitEvery - 1) / config.refitEvery;
+    std::size_t blockCount = std::min<std::size_t>(threadCount, refitCount);
+    std::size_t refitsPerBlock = (refitCount + blockCount - 1) / blockCount;
+    std::size_t originsPerBlock = refitsPerBlock * config.refitEvery;
+
+    std::vector<FitWorkspace> workspaces(threadCount);
+    std::vector<std::size_t> blockRefits(blockCount, 0);
+    parallelFor(blockCount, threadCount, [&](std::size_t block, unsigned worker) {
+        FitWorkspace& workspace = workspaces[worker];
+        ModelFit fit;
+        bool fitted = false;
+
+        std::size_t first = block * originsPerBlock;
+        std::size_t last = std::min(first + originsPerBlock, originCount);
+        for (std::size_t i = first; i < last; ++i) {
+            std::size_t origin = result.origins[i];
+            std::size_t start = config.expanding ? 0 : origin - config.initialWindow;
+            const double* window = values.data() + start;
+            std::size_t count = origin - start;
+
+            if ((i - first) % config.refitEvery == 0) {
+                fit = fitModel(type, window, count, p, q, workspace, fitted ? &fit : nullptr);
+                fitted = true;
+                blockRefits[block]++;
+            } else {
+                // Reuse parameters, only residuals at the new origin are needed
+                computeResiduals(type, fit, {window, count, p, q}, workspace);
+            }
+            forecastFit(fit, window, workspace.residuals.data(), count, config.horizon, &result.forecasts[i * horizon]);
+        }
+    });
+
+    // Aggregate errors per horizon, forecasts past the end of the data are
+    // not scored
+    std::vector<double> sumSq(horizon, 0.0);
+    std::vector<double> sumAbs(horizon, 0.0);
+    result.counts.assign(horizon, 0);
+    for (std::size_t i = 0; i < originCount; ++i) {
+        std::size_t origin = result.origins[i];
+        for (std::size_t h = 0; h < horizon && origin + h < n; ++h) {
+            double error = values[origin + h] - result.forecasts[i * horizon + h];
+            sumSq[h] += error * error;
+            sumAbs[h] += std::abs(error);
+            result.counts[h]++;
+        }
+    }
+    for (std::size_t h = 0; h < horizon; ++h) {
+        double count = static_cast<double>(result.counts[h]);
+        result.rmse.push_back(result.counts[h] ? std::sqrt(sumSq[h] / count) : std::numeric_limits<double>::quiet_NaN());
+        result.mae.push_back(result.counts[h] ? sumAbs[h] / count : std::numeric_limits<double>::quiet_NaN());
+    }
+    for (const auto refits : blockRefits) {
+        result.refits += refits;
+    }
+
+    return result;
+}
+
+std::string WalkForwardResult::toString() const {
+    std::vector<std::vector<std::string>> tableData;
+    for (std::size_t h = 0; h < rmse.size(); ++h) {
+        tableData.push_back({
+            fmt::format("{}", h + 1),
+            fmt::format("{}", counts[h]),
+            fmt::format("{:.4f}", rmse[h]),
+            fmt::format("{:.4f}", mae[h])
+        });
+    }
+    return getTable(
+        fmt::format("Walk Forward ({} origins, {} refits)", origins.size(), refits),
+        tableData,
+        {10, 10, 12, 12},
+        {"Horizon", "Forecasts", "RMSE", "MAE"},
+        false
+    );
+}
@@ -0,0 +1,41 @@
+#include "timeseries/fitting.hpp"
+
+ModelFit fitModel(ModelType type, const double* data, std::size_t count, int arOrder, int maOrder, FitWorkspace& workspace, const ModelFit* warmStart) {
+    switch (type) {
+        case ModelType::AR:   return fitAR(data, count, arOrder, workspace, warmStart);
+        case ModelType::MA:   return fitMA(data, count, maOrder, workspace, warmStart);
+        default:              return fitARMA(data, count, arOrder, maOrder, workspace, warmStart);
+    }
+}
+
+void computeResiduals(ModelType type, const ModelFit& fit, const SeriesView& series, FitWorkspace& workspace) {
+    workspace.reserve(series.count, series.p, series.q);
+    fit.getParams(workspace.x);
+    switch (type) {
+        case ModelType::AR:   getNLLAR(workspace.x.data(), series, workspace); break;
+        case ModelType::MA:   getNLLMA(workspace.x.data(), series, workspace); break;
+        case ModelType::ARMA: getNLLARMA(workspace.x.data(), series, workspace); break;
+    }
+}
+
+void forecastFit(const ModelFit& fit, const double* data, const double* residuals, std::size_t count, int steps, double* out) {
+    const int p = fit.phis.size();
+    const int q = fit.thetas.size();
+    const std::ptrdiff_t end = count;
+
+    for (int h = 0; h < steps; ++h) {
+        double prediction = fit.c;
+
+        // AR part, lags past the end of the data are earlier forecasts
+        for (int j = 0; j < p; ++j) {
+            std::ptrdiff_t lag = h - j - 1;
+            prediction += fit.phis[j] * (lag >= 0 ? out[lag] : data[end + lag]);
+        }
+
+        // MA part, only shocks already observed contribute
+        for (int j = h; j < q; ++j) {
+            prediction += fit.thetas[j] * residuals[end + h - j - 1];
+        }
+        out[h] = prediction;
+    }
+}
@@ -0,0 +1,233 @@
+#include "timeseries/forecasting.hpp"
+#include "print_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+void LagBuffer::reset(const double* data, std::size_t count, std::size_t capacity) {
+    this->capacity = capacity;
+    this->buffer.assign(2 * capacity, 0.0);
+    this->position = capacity == 0 ? 0 : capacity - 1;
+
+    // Right align the available values in the window
+    std::size_t available = std::min(count, capacity);
+    std::copy(data + count - available, data + count, this->buffer.begin() + capacity - available);
+    std::copy(this->buffer.begin(), this->buffer.begin() + capacity, this->buffer.begin() + capacity);
+}
+
+void ForecastState::reset(const ModelFit& fit, const double* data, const double* residuals, std::size_t count, std::time_t lastDate) {
+    reset(fit, data, count, residuals, count, lastDate);
+}
+
+void ForecastState::reset(const ModelFit& fit, const double* values, std::size_t valueCount, const double* residuals, std::size_t residualCount, std::time_t lastDate) {
+    setCoefficients(fit.c, fit.phis, fit.thetas);
+    this->values.reset(values, valueCount, fit.phis.size());
+    this->residuals.reset(residuals, residualCount, fit.thetas.size());
+    this->lastDate = lastDate;
+    this->ready = true;
+}
+
+void ForecastState::setCoefficients(double c, const std::vector<double>& phis, const std::vector<double>& thetas) {
+    this->c = c;
+    this->arLags.assign(phis.rbegin(), phis.rend());
+    this->maLags.assign(thetas.rbegin(), thetas.rend());
+}
+
+void ForecastState::forecast(int steps, double* out) const {
+    if (!this->ready) {
+        throw std::runtime_error("Could not forecast: model is untrained");
+    }
+    const int p = this->arLags.size();
+    const int q = this->maLags.size();
+
+    // Roll copies of the lag windows forward, forecasts become AR lags and
+    // future shocks are zero
+    LagBuffer values = this->values;
+    LagBuffer residuals = this->residuals;
+    for (int h = 0; h < steps; ++h) {
+        double prediction = this->c + lagDot(this->arLags.data(), values.window(), p) + lagDot(this->maLags.data(), residuals.window(), q);
+        out[h] = prediction;
+        values.push(prediction);
+        residuals.push(0.0);
+    }
+}
+
+void getPsiWeights(const std::vector<double>& phis, const std::vector<double>& thetas, int count, double* out) {
+    const int p = phis.size();
+    const int q = thetas.size();
+    for (int j = 0; j < count; ++j) {
+        double psi = j == 0 ? 1.0 : (j <= q ? thetas[j - 1] : 0.0);
+        for (int i = 1; i <= std::min(j, p); ++i) {
+            psi += phis[i - 1] * out[j - i];
+        }
+        out[j] = psi;
+    }
+}
+
+void differenceInPlace(double* data, std::size_t count, int d, double* tails) {
+    for (int k = 0; k < d; ++k) {
+        // Series k occupies data[k, count), walk backwards so each value is
+        // read before it is overwritten
+        tails[k] = data[count - 1];
+        for (std::size_t t = count - 1; t > static_cast<std::size_t>(k); --t) {
+            data[t] -= data[t - 1];
+        }
+    }
+}
+
+void integrateInPlace(double* values, std::size_t count, int d, const double* tails) {
+    for (int k = d - 1; k >= 0; --k) {
+        double level = tails[k];
+        for (std::size_t h = 0; h < count; ++h) {
+            level += values[h];
+            values[h] = level;
+        }
+    }
+}
+
+double getNormalQuantile(double probability) {
+    if (!(probability > 0.0 && probability < 1.0)) {
+        throw std::invalid_argument("Could not get normal quantile: probability must be in (0, 1)");
+    }
+
+    // Acklam's rational approximation, relative error below 1.2e-9
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+    const double tail = 0.02425;
+
+    if (probability < tail) {
+        double r = std::sqrt(-2 * std::log(probability));
+        return (((((c[0] * r + c[1]) * r + c[2]) * r + c[3]) * r + c[4]) * r + c[5]) / ((((d[0] * r + d[1]) * r + d[2]) * r + d[3]) * r + 1);
+    }
+    if (probability > 1 - tail) {
+        double r = std::sqrt(-2 * std::log(1 - probability));
+        return -(((((c[0] * r + c[1]) * r + c[2]) * r + c[3]) * r + c[4]) * r + c[5]) / ((((d[0] * r + d[1]) * r + d[2]) * r + d[3]) * r + 1);
+    }
+    double r = probability - 0.5;
+    double s = r * r;
+    return (((((a[0] * s + a[1]) * s + a[2]) * s + a[3]) * s + a[4]) * s + a[5]) * r / (((((b[0] * s + b[1]) * s + b[2]) * s + b[3]) * s + b[4]) * s + 1);
+}
+
+ForecastResult ForecastState::forecast(const std::vector<int>& horizons, double sigma, double level) const {
+    if (!this->ready) {
+        throw std::runtime_error("Could not forecast: model is untrained");
+    }
+    if (!(level > 0.0 && level < 1.0)) {
+        throw std::invalid_argument("Could not forecast: level must be in (0, 1)");
+    }
+    for (int h : horizons) {
+        if (h < 1) {
+            throw std::invalid_argument("Could not forecast: horizons must be at least 1");
+        }
+    }
+
+    const int p = this->arLags.size();
+    const int q = this->maLags.size();
+    const std::size_t n = horizons.size();
+
+    ForecastResult result;
+    result.horizons = horizons;
+    result.level = level;
+    result.mean.resize(n);
+    result.stdErr.resize(n);
+    result.lower.resize(n);
+    result.upper.resize(n);
+    if (n == 0) {
+        return result;
+    }
+
+    // Visit horizons in increasing order
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return horizons[a] < horizons[b]; });
+    const int maxHorizon = horizons[order.back()];
+
+    // Recursive forecasts while MA terms still contribute
+    const int direct = std::min(std::max(p, q), maxHorizon);
+    std::vector<double> path(direct);
+    forecast(direct, path.data());
+
+    // Augmented companion state z_t = [X_t, ..., X_{t-p+1}, 1] after the
+    // direct steps, with z_{t+1} = A * z_t
+    Eigen::MatrixXd companion = Eigen::MatrixXd::Zero(p + 1, p + 1);
+    Eigen::VectorXd z(p + 1);
+    for (int i = 0; i < p; ++i) {
+        companion(0, i) = this->arLags[p - i - 1];
+        if (i > 0) {
+            companion(i, i - 1) = 1.0;
+        }
+        z(i) = direct - i >= 1 ? path[direct - i - 1] : this->values.getLag(i - direct + 1);
+    }
+    companion(0, p) = this->c;
+    companion(p, p) = 1.0;
+    z(p) = 1.0;
+    int zStep = direct;
+
+    // Running sum of squared psi-weights, the last p weights sit in a lag
+    // window for the recursion
+    LagBuffer psiWindow;
+    psiWindow.reset(nullptr, 0, p);
+    double sumPsiSq = 0.0;
+    int psiCount = 0;
+
+    const double quantile = getNormalQuantile(0.5 + 0.5 * level);
+    for (std::size_t k : order) {
+        const int h = horizons[k];
+
+        // Mean, jumping the companion state forward by squaring
+        if (h <= direct) {
+            result.mean[k] = path[h - 1];
+        } else if (p == 0) {
+            // Without AR terms the forecast settles on the constant
+            result.mean[k] = this->c;
+        } else {
+            int gap = h - zStep;
+            Eigen::MatrixXd power = companion;
+            while (gap > 0) {
+                if (gap & 1) {
+                    z = power * z;
+                }
+                gap >>= 1;
+                if (gap > 0) {
+                    power = power * power;
+                }
+            }
+            zStep = h;
+            result.mean[k] = z(0);
+        }
+
+        // Error variance sigma^2 * (psi_0^2 + ... + psi_{h-1}^2)
+        for (; psiCount < h; ++psiCount) {
+            double psi = psiCount == 0 ? 1.0 : (psiCount <= q ? this->maLags[q - psiCount] : 0.0);
+            psi += lagDot(this->arLags.data(), psiWindow.window(), p);
+            psiWindow.push(psi);
+            sumPsiSq += psi * psi;
+        }
+        result.stdErr[k] = sigma * std::sqrt(sumPsiSq);
+        result.lower[k] = result.mean[k] - quantile * result.stdErr[k];
+        result.upper[k] = result.mean[k] + quantile * result.stdErr[k];
+    }
+
+    return result;
+}
+
+std::string ForecastResult::toString() const {
+    std::vector<std::string> columnHeaders = {"Horizon", "Mean", "Std Err", "Lower", "Upper"};
+    std::vector<int> columnWidths(columnHeaders.size(), 10);
+
+    std::vector<std::vector<std::string>> tableData;
+    for (std::size_t i = 0; i < size(); ++i) {
+        tableData.push_back({
+            fmt::format("{}", horizons[i]),
+            fmt::format("{:.4f}", mean[i]),
+            fmt::format("{:.4f}", stdErr[i]),
+            fmt::format("{:.4f}", lower[i]),
+            fmt::format("{:.4f}", upper[i])
+        });
+    }
+    return getTable(fmt::format("Forecast ({:.0f}% Intervals)", 100 * level), tableData, columnWidths, columnHeaders, false);
+}
@@ -0,0 +1,402 @@
+#include "timeseries/timeseries_models.hpp"
+
+GARCH::GARCH(const TimeSeries<double>& data) {
+    this->data = data;
+    this->count = data.size();
+    this->name = "GARCH Model (Untrained)";
+
+    // Mark model as untrained
+    this->arOrder = -1;
+    this->maOrder = -1;
+
+    this->c = 0;
+    this->omega = 0;
+    this->alpha = 0;
+    this->beta = 0;
+    this->nll = 0;
+
+    this->mse = 0;
+    this->rmse = 0;
+    this->mae = 0;
+}
+
+nlopt::opt& GARCHWorkspace::getOptimizer(unsigned dimension, double xtolRel, int maxEval) {
+    if (this->dimension != dimension) {
+        optimizer = nlopt::opt(nlopt::LD_SLSQP, dimension);
+        this->dimension = dimension;
+
+        // Mean parameters are free, variance parameters must keep the
+        // variance positive
+        std::vector<double> lower(dimension, -HUGE_VAL);
+        std::vector<double> upper(dimension, HUGE_VAL);
+        lower[dimension - 3] = 1e-12;
+        lower[dimension - 2] = 0.0;
+        upper[dimension - 2] = 1.0;
+        lower[dimension - 1] = 0.0;
+        upper[dimension - 1] = 1.0;
+        optimizer.set_lower_bounds(lower);
+        optimizer.set_upper_bounds(upper);
+    }
+    optimizer.set_xtol_rel(xtolRel);
+    optimizer.set_maxeval(maxEval);
+    return optimizer;
+}
+
+double getNLLGARCH(const double* params, const SeriesView& series, GARCHWorkspace& workspace, double* grad) {
+    double mu = params[0];
+    const double* data = series.data;
+    size_t count = series.count;
+    int p = series.p;
+    int q = series.q;
+    int m = 1 + p + q; // Mean parameters
+    int start = std::max(p, q);
+
+    const double omega = params[m];
+    const double alpha = params[m + 1];
+    const double beta = params[m + 2];
+
+    double* residuals = workspace.residuals.data();
+    double* variances = workspace.variances.data();
+    double* residualGrads = workspace.residualGrads.data();
+    double* varianceGrads = workspace.varianceGrads.data();
+
+    // Reverse coefficients so lag j lines up with t-j in the windows ending at t
+    double* arLags = workspace.arLags.data();
+    double* maLags = workspace.maLags.data();
+    for (int i = 0; i < p; ++i) {
+        arLags[p - i - 1] = params[i + 1];
+    }
+    for (int i = 0; i < q; ++i) {
+        maLags[q - i - 1] = params[p + i + 1];
+    }
+
+    // Shocks before the first full lag window are taken as zero
+    std::fill(residuals, residuals + start, 0.0);
+    std::fill(variances, variances + start, workspace.backcast);
+    if (grad) {
+        std::fill(grad, grad + m + 3, 0.0);
+        std::fill(residualGrads, residualGrads + start * m, 0.0);
+        std::fill(varianceGrads, varianceGrads + m + 3, 0.0);
+    }
+
+    double nll = 0.0;
+    double lastShockSq = workspace.backcast;
+    double lastVariance = workspace.backcast;
+    for (size_t t = start; t < count; ++t) {
+        // e_t = X_t - c - phi_1 * X_{t-1} - ... - theta_1 * e_{t-1} - ...
+        double residual = data[t] - mu - lagDot(arLags, data + t - p, p) - lagDot(maLags, residuals + t - q, q);
+
+        // h_t = omega + alpha * e_{t-1}^2 + beta * h_{t-1}
+        double variance = omega + alpha * lastShockSq + beta * lastVariance;
+        if (!(variance > 0.0)) {
+            return HUGE_VAL;
+        }
+
+        if (grad) {
+            double* de = residualGrads + t * m;
+            // dh_t = d(alpha * e_{t-1}^2) + beta * dh_{t-1}, updated in place.
+            // The backcast first variance does not depend on the mean params.
+            if (t > static_cast<size_t>(start)) {
+                const double* dePrev = de - m;
+                for (int k = 0; k < m; ++k) {
+                    varianceGrads[k] = beta * varianceGrads[k] + 2.0 * alpha * residuals[t - 1] * dePrev[k];
+                }
+            }
+            varianceGrads[m] = 1.0 + beta * varianceGrads[m];
+            varianceGrads[m + 1] = lastShockSq + beta * varianceGrads[m + 1];
+            varianceGrads[m + 2] = lastVariance + beta * varianceGrads[m + 2];
+
+            // de_t = -[1, X_{t-1..t-p}, e_{t-1..t-q}] - sum_j theta_j * de_{t-j}
+            de[0] = -1.0;
+            for (int i = 0; i < p; ++i) {
+                de[1 + i] = -data[t - i - 1];
+            }
+            for (int j = 0; j < q; ++j) {
+                de[1 + p + j] = -residuals[t - j - 1];
+            }
+            Eigen::Map<Eigen::VectorXd> deRow(de, m);
+            for (int j = 0; j < q; ++j) {
+                deRow -= params[p + j + 1] * Eigen::Map<const Eigen::VectorXd>(de - (j + 1) * m, m);
+            }
+
+            // d(0.5 * (log h_t + e_t^2 / h_t))
+            const double inverse = 1.0 / variance;
+            const double varianceWeight = 0.5 * inverse * (1.0 - residual * residual * inverse);
+            const double residualWeight = residual * inverse;
+            for (int k = 0; k < m; ++k) {
+                grad[k] += varianceWeight * varianceGrads[k] + residualWeight * de[k];
+            }
+            for (int k = m; k < m + 3; ++k) {
+                grad[k] += varianceWeight * varianceGrads[k];
+            }
+        }
+
+        residuals[t] = residual;
+        variances[t] = variance;
+        nll += std::log(variance) + residual * residual / variance;
+
+        lastShockSq = residual * residual;
+        lastVariance = variance;
+    }
+
+    return 0.5 * ((count - start) * std::log(2 * M_PI) + nll);
+}
+
+double objFunctionGARCH(const std::vector<double>& x, std::vector<double>& grad, void* data) {
+    GARCHObjectiveData* objective = static_cast<GARCHObjectiveData*>(data);
+    return getNLLGARCH(x.data(), objective->series, *objective->workspace, grad.empty() ? nullptr : grad.data());
+}
+
+// alpha + beta < 1 keeps the variance process stationary
+double persistenceConstraint(const std::vector<double>& x, std::vector<double>& grad, void*) {
+    size_t n = x.size();
+    if (!grad.empty()) {
+        std::fill(grad.begin(), grad.end(), 0.0);
+        grad[n - 2] = 1.0;
+        grad[n - 1] = 1.0;
+    }
+    return x[n - 2] + x[n - 1] - (1.0 - 1e-6);
+}
+
+GARCHFit fitGARCH(const double* data, size_t count, int arOrder, int maOrder, GARCHWorkspace& workspace, const GARCHFit* warmStart) {
+    int meanCount = arOrder + maOrder + 1;
+    int paramCount = meanCount + 3; // Mean params, omega, alpha and beta
+    if (arOrder < 0 || maOrder < 0) {
+        throw std::invalid_argument("Could not fit GARCH model: orders must be non-negative");
+    }
+    if (count <= static_cast<size_t>(std::max(arOrder, maOrder) + paramCount)) {
+        throw std::invalid_argument("Could not fit GARCH model: not enough data for the requested orders");
+    }
+
+    nlopt::opt& optimizer = workspace.getOptimizer(paramCount, 1e-7, 2000);
+    SeriesView series = {data, count, arOrder, maOrder};
+    workspace.reserve(count, arOrder, maOrder);
+
+    // Backcast the variance before the first shock with the sample variance
+    double mean = std::accumulate(data, data + count, 0.0) / count;
+    double sumSq = 0.0;
+    for (size_t t = 0; t < count; ++t) {
+        sumSq += (data[t] - mean) * (data[t] - mean);
+    }
+    workspace.backcast = sumSq / count;
+
+    std::vector<double>& x = workspace.x;
+    if (warmStart) {
+        warmStart->mean.getParams(x);
+        if (x.size() != static_cast<size_t>(meanCount)) {
+            throw std::invalid_argument("Could not fit GARCH model: warm start has the wrong orders");
+        }
+        x.push_back(warmStart->omega);
+        x.push_back(warmStart->alpha);
+        x.push_back(warmStart->beta);
+    } else {
+        // Start from the sample mean and a persistent variance process with
+        // the sample variance as its long-run level
+        x.assign(paramCount, 0.1);
+        x[0] = mean;
+        x[meanCount] = 0.1 * workspace.backcast;
+        x[meanCount + 1] = 0.05;
+        x[meanCount + 2] = 0.85;
+    }
+
+    GARCHFit fit;
+    try {
+        // Data wrapper to pass model order and workspace to objective function
+        GARCHObjectiveData objective = {series, &workspace};
+        optimizer.set_min_objective(objFunctionGARCH, &objective);
+        optimizer.remove_inequality_constraints();
+        optimizer.add_inequality_constraint(persistenceConstraint, nullptr, 1e-10);
+        optimizer.optimize(x, fit.mean.nll);
+    } catch (const std::exception &e) {
+        std::cerr << "nlopt failed: " << e.what() << std::endl;
+    }
+
+    // Save learnt parameters
+    fit.mean.c = x[0];
+    fit.mean.phis.assign(x.begin() + 1, x.begin() + 1 + arOrder);
+    fit.mean.thetas.assign(x.begin() + 1 + arOrder, x.begin() + meanCount);
+    fit.omega = x[meanCount];
+    fit.alpha = x[meanCount + 1];
+    fit.beta = x[meanCount + 2];
+
+    // Set metrics from the shocks of the learnt parameters on the training data
+    fit.mean.nll = getNLLGARCH(x.data(), series, workspace, nullptr);
+    size_t start = std::max(arOrder, maOrder);
+    double sumResidualsSq = 0.0;
+    double sumAbs = 0.0;
+    for (size_t t = start; t < count; ++t) {
+        const double residual = workspace.residuals[t];
+        sumResidualsSq += residual * residual;
+        sumAbs += std::abs(residual);
+    }
+    fit.mean.mse = sumResidualsSq / (count - start);
+    fit.mean.rmse = std::sqrt(fit.mean.mse);
+    fit.mean.mae = sumAbs / (count - start);
+
+    return fit;
+}
+
+void GARCH::train(int arOrder, int maOrder) {
+    this->arOrder = arOrder;
+    this->maOrder = maOrder;
+
+    // Construct data vector
+    std::vector<double> dataVec;
+    for (const auto& [date, value] : this->data) {
+        dataVec.push_back(value);
+    }
+
+    GARCHWorkspace workspace;
+    GARCHFit fit = fitGARCH(dataVec.data(), dataVec.size(), arOrder, maOrder, workspace);
+
+    // Save learnt parameters and metrics
+    this->c = fit.mean.c;
+    this->phis = fit.mean.phis;
+    this->thetas = fit.mean.thetas;
+    this->omega = fit.omega;
+    this->alpha = fit.alpha;
+    this->beta = fit.beta;
+    this->nll = fit.mean.nll;
+    this->mse = fit.mean.mse;
+    this->rmse = fit.mean.rmse;
+    this->mae = fit.mean.mae;
+    this->residuals = workspace.residuals;
+    this->variances = workspace.variances;
+    this->state.reset(fit.mean, dataVec.data(), this->residuals.data(), dataVec.size(), this->data.rbegin()->first);
+
+    // Set new name
+    this->name = arOrder == 0 && maOrder == 0 ?
+        "GARCH(1, 1) Model" :
+        fmt::format("ARMA({}, {})-GARCH(1, 1) Model", arOrder, maOrder);
+}
+
+std::vector<double> GARCH::forecastVariance(int steps) const {
+    if (this->arOrder < 0) {
+        throw std::runtime_error("Could not forecast GARCH variance: model is untrained");
+    }
+
+    // h_{T+1} = omega + alpha * e_T^2 + beta * h_T, after which the expected
+    // squared shock equals the variance: h_{T+k} = omega + (alpha + beta) * h_{T+k-1}
+    std::vector<double> forecasts(steps);
+    double lastShock = this->residuals.back();
+    double variance = this->omega + this->alpha * lastShock * lastShock + this->beta * this->variances.back();
+    for (int i = 0; i < steps; ++i) {
+        forecasts[i] = variance;
+        variance = this->omega + (this->alpha + this->beta) * variance;
+    }
+    return forecasts;
+}
+
+ForecastResult GARCH::forecastIntervals(const std::vector<int>& horizons, double level) const {
+    // Means and argument checks come from the ARMA lag state
+    ForecastResult result = this->state.forecast(horizons, this->rmse, level);
+    if (result.size() == 0) {
+        return result;
+    }
+    const int maxHorizon = *std::max_element(horizons.begin(), horizons.end());
+
+    // The shock j steps before horizon h enters with weight psi_j and the
+    // variance of its own step: Var = sum_{j < h} psi_j^2 * h_{T+h-j}
+    std::vector<double> variances = forecastVariance(maxHorizon);
+    std::vector<double> psi(maxHorizon);
+    getPsiWeights(this->phis, this->thetas, maxHorizon, psi.data());
+
+    const double quantile = getNormalQuantile(0.5 + 0.5 * level);
+    for (std::size_t k = 0; k < result.size(); ++k) {
+        const int h = horizons[k];
+        double variance = 0.0;
+        for (int j = 0; j < h; ++j) {
+            variance += psi[j] * psi[j] * variances[h - j - 1];
+        }
+        result.stdErr[k] = std::sqrt(variance);
+        result.lower[k] = result.mean[k] - quantile * result.stdErr[k];
+        result.upper[k] = result.mean[k] + quantile * result.stdErr[k];
+    }
+    return result;
+}
+
+ModelFit GARCH::getFit() const {
+    ModelFit fit;
+    fit.c = this->c;
+    fit.phis = this->phis;
+    fit.thetas = this->thetas;
+    fit.nll = this->nll;
+    fit.mse = this->mse;
+    fit.rmse = this->rmse;
+    fit.mae = this->mae;
+    return fit;
+}
+
+GARCHFit GARCH::getGARCHFit() const {
+    GARCHFit fit;
+    fit.mean = this->getFit();
+    fit.omega = this->omega;
+    fit.alpha = this->alpha;
+    fit.beta = this->beta;
+    return fit;
+}
+
+std::vector<double> GARCH::getPhis() const {
+    return this->phis;
+}
+
+std::vector<double> GARCH::getThetas() const {
+    return this->thetas;
+}
+
+double GARCH::getOmega() const {
+    return this->omega;
+}
+
+double GARCH::getAlpha() const {
+    return this->alpha;
+}
+
+double GARCH::getBeta() const {
+    return this->beta;
+}
+
+double GARCH::getNLL() const {
+    return this->nll;
+}
+
+std::vector<double> GARCH::getVariances() const {
+    return this->variances;
+}
+
+std::string GARCH::toString() const {
+    auto columnWidths = {12, 12};
+    int totalWidth = std::accumulate(columnWidths.begin(), columnWidths.end(), 0) + columnWidths.size() - 1;
+    auto justifications = {Justification::LEFT, Justification::RIGHT};
+    auto colors = {Color::WHITE, Color::WHITE};
+
+    // Title
+    auto table = getTopLine({totalWidth});
+    table += getRow({this->name}, {totalWidth}, {Justification::CENTER}, {Color::WHITE});
+
+    // Mean params
+    table += getMidLine({columnWidths}, Ticks::LOWER);
+    for (int i = 0; i < this->arOrder; ++i) {
+        table += getRow({fmt::format("phi_{}", i + 1), fmt::format("{:.4f}", this->phis[i])}, columnWidths, justifications, colors);
+    }
+    for (int i = 0; i < this->maOrder; ++i) {
+        table += getRow({fmt::format("theta_{}", i + 1), fmt::format("{:.4f}", this->thetas[i])}, columnWidths, justifications, colors);
+    }
+    table += getRow({"const", fmt::format("{:.4f}", this->c)}, columnWidths, justifications, colors);
+
+    // Variance params
+    table += getMidLine({columnWidths}, Ticks::BOTH);
+    table += getRow({"omega", fmt::format("{:.4f}", this->omega)}, columnWidths, justifications, colors);
+    table += getRow({"alpha", fmt::format("{:.4f}", this->alpha)}, columnWidths, justifications, colors);
+    table += getRow({"beta", fmt::format("{:.4f}", this->beta)}, columnWidths, justifications, colors);
+
+    // Metrics
+    table += getMidLine({columnWidths}, Ticks::BOTH);
+    table += getRow({"NLL", fmt::format("{:.4f}", this->nll)}, columnWidths, justifications, colors);
+    table += getRow({"MSE", fmt::format("{:.4f}", this->mse)}, columnWidths, justifications, colors);
+    table += getRow({"RMSE", fmt::format("{:.4f}", this->rmse)}, columnWidths, justifications, colors);
+    table += getRow({"MAE", fmt::format("{:.4f}", this->mae)}, columnWidths, justifications, colors);
+    table += getBottomLine(columnWidths);
+
+    return table;
+}
@@ -0,0 +1,326 @@
+#include "timeseries/timeseries_models.hpp"
+#include "thread_utils.hpp"
+
+// Grid points per smoothing parameter in the coarse search
+constexpr int HOLT_WINTERS_GRID = 10;
+
+double getSSEHoltWinters(const double* data, size_t count, const double* params, HoltWintersFit& fit, double* residuals) {
+    const double alpha = params[0];
+    const double beta = params[1];
+    const double gamma = params[2];
+    const size_t period = std::max(fit.period, 0);
+    const size_t start = getHoltWintersStart(fit.period);
+    auto& seasonals = fit.seasonals;
+
+    // Level and trend from the first two seasons, seasonals as the first
+    // season's deviations from its mean
+    double level;
+    double trend;
+    if (period > 0) {
+        double first = std::accumulate(data, data + period, 0.0) / period;
+        double second = std::accumulate(data + period, data + 2 * period, 0.0) / period;
+        level = first;
+        trend = (second - first) / period;
+        seasonals.resize(period);
+        for (size_t i = 0; i < period; ++i) {
+            seasonals[i] = data[i] - first;
+        }
+    } else {
+        level = data[1];
+        trend = data[1] - data[0];
+        seasonals.clear();
+    }
+    if (residuals) {
+        std::fill(residuals, residuals + start, 0.0);
+    }
+
+    // One pass: error, then level, trend and seasonal updates. seasonals is a
+    // ring, position s holds the season of t.
+    double sse = 0.0;
+    double sumAbs = 0.0;
+    size_t s = 0;
+    for (size_t t = start; t < count; ++t) {
+        const double season = period > 0 ? seasonals[s] : 0.0;
+        const double error = data[t] - (level + trend + season);
+        sse += error * error;
+        sumAbs += std::abs(error);
+        if (residuals) {
+            residuals[t] = error;
+        }
+
+        const double previous = level;
+        level = alpha * (data[t] - season) + (1.0 - alpha) * (level + trend);
+        trend = beta * (level - previous) + (1.0 - beta) * trend;
+        if (period > 0) {
+            seasonals[s] = gamma * (data[t] - level) + (1.0 - gamma) * season;
+            if (++s == period) {
+                s = 0;
+            }
+        }
+    }
+
+    // Rotate so the next step's season comes first
+    std::rotate(seasonals.begin(), seasonals.begin() + s, seasonals.end());
+    fit.alpha = alpha;
+    fit.beta = beta;
+    fit.gamma = gamma;
+    fit.level = level;
+    fit.trend = trend;
+    fit.sse = sse;
+    fit.mse = sse / (count - start);
+    fit.rmse = std::sqrt(fit.mse);
+    fit.mae = sumAbs / (count - start);
+
+    return sse;
+}
+
+struct HoltWintersObjectiveData {
+    const double* data;
+    size_t count;
+    HoltWintersFit* fit;
+};
+
+double objFunctionHoltWinters(const std::vector<double>& x, std::vector<double>&, void* data) {
+    HoltWintersObjectiveData* objective = static_cast<HoltWintersObjectiveData*>(data);
+    double params[3] = {x[0], x[1], x.size() > 2 ? x[2] : 0.0};
+    return getSSEHoltWinters(objective->data, objective->count, params, *objective->fit);
+}
+
+HoltWintersFit fitHoltWinters(const double* data, size_t count, int period, unsigned threadCount) {
+    if (period < 0 || period == 1) {
+        throw std::invalid_argument("Could not fit Holt-Winters model: period must be 0 or at least 2");
+    }
+    if (count <= getHoltWintersStart(period) + static_cast<size_t>(period)) {
+        throw std::invalid_argument("Could not fit Holt-Winters model: not enough data for the period");
+    }
+
+    // Coarse grid over (0, 1) for each parameter, gamma fixed without a season
+    const bool seasonal = period > 0;
+    const size_t gammaCount = seasonal ? HOLT_WINTERS_GRID : 1;
+    const size_t gridCount = HOLT_WINTERS_GRID * HOLT_WINTERS_GRID * gammaCount;
+    auto gridValue = [](size_t i) { return (i + 0.5) / HOLT_WINTERS_GRID; };
+
+    std::vector<HoltWintersFit> scratch(getThreadCount(threadCount));
+    for (auto& fit : scratch) {
+        fit.period = period;
+    }
+    std::vector<double> sse(gridCount);
+    parallelFor(gridCount, threadCount, [&](size_t i, unsigned worker) {
+        double params[3] = {gridValue(i / (HOLT_WINTERS_GRID * gammaCount)),
+                            gridValue(i / gammaCount % HOLT_WINTERS_GRID),
+                            seasonal ? gridValue(i % gammaCount) : 0.0};
+        sse[i] = getSSEHoltWinters(data, count, params, scratch[worker]);
+    });
+    size_t best = std::min_element(sse.begin(), sse.end()) - sse.begin();
+
+    // Refine locally from the best grid point within the unit box
+    std::vector<double> x = {gridValue(best / (HOLT_WINTERS_GRID * gammaCount)), gridValue(best / gammaCount % HOLT_WINTERS_GRID)};
+    if (seasonal) {
+        x.push_back(gridValue(best % gammaCount));
+    }
+    HoltWintersFit fit;
+    fit.period = period;
+    try {
+        nlopt::opt optimizer(nlopt::LN_COBYLA, x.size());
+        optimizer.set_lower_bounds(std::vector<double>(x.size(), 0.0));
+        optimizer.set_upper_bounds(std::vector<double>(x.size(), 1.0));
+        optimizer.set_xtol_rel(1e-6);
+        optimizer.set_maxeval(500);
+
+        // Data wrapper to pass the series and scratch states to objective function
+        HoltWintersObjectiveData objective = {data, count, &fit};
+        optimizer.set_min_objective(objFunctionHoltWinters, &objective);
+        double minSSE;
+        optimizer.optimize(x, minSSE);
+    } catch (const std::exception &e) {
+        std::cerr << "nlopt failed: " << e.what() << std::endl;
+    }
+
+    // Keep the grid point if refinement made things worse, then set the final
+    // states of the chosen parameters
+    double params[3] = {x[0], x[1], seasonal ? x[2] : 0.0};
+    if (getSSEHoltWinters(data, count, params, fit) > sse[best]) {
+        params[0] = gridValue(best / (HOLT_WINTERS_GRID * gammaCount));
+        params[1] = gridValue(best / gammaCount % HOLT_WINTERS_GRID);
+        params[2] = seasonal ? gridValue(best % gammaCount) : 0.0;
+        getSSEHoltWinters(data, count, params, fit);
+    }
+
+    return fit;
+}
+
+HoltWinters::HoltWinters(const TimeSeries<double>& data) {
+    this->data = data;
+    this->count = data.size();
+    this->name = "Holt-Winters Model (Untrained)";
+
+    // Mark model as untrained
+    this->fit.period = -1;
+
+    this->c = 0;
+
+    this->mse = 0;
+    this->rmse = 0;
+    this->mae = 0;
+}
+
+void HoltWinters::train(int period, unsigned threadCount) {
+    std::vector<double> dataVec;
+    dataVec.reserve(this->count);
+    for (const auto& [date, value] : this->data) {
+        dataVec.push_back(value);
+    }
+    HoltWintersFit fit = fitHoltWinters(dataVec.data(), dataVec.size(), period, threadCount);
+
+    // One more pass for the residuals of the chosen parameters
+    double params[3] = {fit.alpha, fit.beta, fit.gamma};
+    this->residuals.resize(this->count);
+    getSSEHoltWinters(dataVec.data(), dataVec.size(), params, fit, this->residuals.data());
+
+    // Save learnt parameters and metrics, the level stands in for the constant
+    this->fit = fit;
+    this->c = fit.level;
+    this->mse = fit.mse;
+    this->rmse = fit.rmse;
+    this->mae = fit.mae;
+    this->state.lastDate = this->data.rbegin()->first;
+
+    // Set new name
+    this->name = period > 0 ? fmt::format("Holt-Winters({}) Model", period) : "Holt Linear Trend Model";
+}
+
+void HoltWinters::forecast(int steps, double* out) const {
+    if (this->fit.period < 0) {
+        throw std::runtime_error("Could not forecast: model must be trained first");
+    }
+    const size_t period = this->fit.seasonals.size();
+    for (int h = 1; h <= steps; ++h) {
+        out[h - 1] = this->fit.level + h * this->fit.trend + (period > 0 ? this->fit.seasonals[(h - 1) % period] : 0.0);
+    }
+}
+
+ForecastResult HoltWinters::forecastIntervals(const std::vector<int>& horizons, double level) const {
+    if (!(level > 0.0 && level < 1.0)) {
+        throw std::invalid_argument("Could not forecast: level must be in (0, 1)");
+    }
+    int maxHorizon = 0;
+    for (int h : horizons) {
+        if (h < 1) {
+            throw std::invalid_argument("Could not forecast: horizons must be at least 1");
+        }
+        maxHorizon = std::max(maxHorizon, h);
+    }
+    std::vector<double> path(maxHorizon);
+    forecast(maxHorizon, path.data());
+
+    // In error correction form a shock j steps back moves the forecast by
+    // alpha + j * alpha * beta, plus (1 - alpha) * gamma when j is a whole
+    // number of seasons
+    const double slope = this->fit.alpha * this->fit.beta;
+    const double seasonal = (1.0 - this->fit.alpha) * this->fit.gamma;
+    std::vector<double> sumPsiSq(maxHorizon);
+    double sum = 1.0;
+    for (int j = 0; j < maxHorizon; ++j) {
+        sumPsiSq[j] = sum;
+        double psi = this->fit.alpha + (j + 1) * slope + (this->fit.period > 0 && (j + 1) % this->fit.period == 0 ? seasonal : 0.0);
+        sum += psi * psi;
+    }
+
+    ForecastResult result;
+    result.horizons = horizons;
+    result.level = level;
+    const double quantile = getNormalQuantile(0.5 + 0.5 * level);
+    for (int h : horizons) {
+        double stdErr = this->rmse * std::sqrt(sumPsiSq[h - 1]);
+        result.mean.push_back(path[h - 1]);
+        result.stdErr.push_back(stdErr);
+        result.lower.push_back(path[h - 1] - quantile * stdErr);
+        result.upper.push_back(path[h - 1] + quantile * stdErr);
+    }
+    return result;
+}
+
+SimulationResult HoltWinters::simulate(int steps, const SimulationConfig& config) const {
+    if (this->fit.period < 0) {
+        throw std::runtime_error("Could not simulate paths: model must be trained first");
+    }
+    return simulateHoltWinters(this->fit, this->residuals.data(), this->count, steps, config);
+}
+
+size_t HoltWinters::getResidualStart() const {
+    return getHoltWintersStart(this->fit.period);
+}
+
+ModelFit HoltWinters::getFit() const {
+    ModelFit fit;
+    fit.c = this->c;
+    fit.mse = this->mse;
+    fit.rmse = this->rmse;
+    fit.mae = this->mae;
+    return fit;
+}
+
+HoltWintersFit HoltWinters::getHoltWintersFit() const {
+    return this->fit;
+}
+
+int HoltWinters::getPeriod() const {
+    return this->fit.period;
+}
+
+double HoltWinters::getAlpha() const {
+    return this->fit.alpha;
+}
+
+double HoltWinters::getBeta() const {
+    return this->fit.beta;
+}
+
+double HoltWinters::getGamma() const {
+    return this->fit.gamma;
+}
+
+double HoltWinters::getLevel() const {
+    return this->fit.level;
+}
+
+double HoltWinters::getTrend() const {
+    return this->fit.trend;
+}
+
+std::vector<double> HoltWinters::getSeasonals() const {
+    return this->fit.seasonals;
+}
+
+std::string HoltWinters::toString() const {
+    auto columnWidths = {12, 12};
+    int totalWidth = std::accumulate(columnWidths.begin(), columnWidths.end(), 0) + columnWidths.size() - 1;
+    auto justifications = {Justification::LEFT, Justification::RIGHT};
+    auto colors = {Color::WHITE, Color::WHITE};
+
+    // Title
+    auto table = getTopLine({totalWidth});
+    table += getRow({this->name}, {totalWidth}, {Justification::CENTER}, {Color::WHITE});
+
+    // Smoothing params
+    table += getMidLine({columnWidths}, Ticks::LOWER);
+    table += getRow({"alpha", fmt::format("{:.4f}", this->fit.alpha)}, columnWidths, justifications, colors);
+    table += getRow({"beta", fmt::format("{:.4f}", this->fit.beta)}, columnWidths, justifications, colors);
+    if (this->fit.period > 0) {
+        table += getRow({"gamma", fmt::format("{:.4f}", this->fit.gamma)}, columnWidths, justifications, colors);
+    }
+
+    // Final states
+    table += getMidLine({columnWidths}, Ticks::BOTH);
+    table += getRow({"level", fmt::format("{:.4f}", this->fit.level)}, columnWidths, justifications, colors);
+    table += getRow({"trend", fmt::format("{:.4f}", this->fit.trend)}, columnWidths, justifications, colors);
+
+    // Metrics
+    table += getMidLine({columnWidths}, Ticks::BOTH);
+    table += getRow({"MSE", fmt::format("{:.4f}", this->mse)}, columnWidths, justifications, colors);
+    table += getRow({"RMSE", fmt::format("{:.4f}", this->rmse)}, columnWidths, justifications, colors);
+    table += getRow({"MAE", fmt::format("{:.4f}", this->mae)}, columnWidths, justifications, colors);
+    table += getBottomLine(columnWidths);
+
+    return table;
+}
@@ -14,26 +14,36 @@ MA::MA(const TimeSeries<double>& data) {
     this->mae = 0.0;
 }
 
-double getNLLMA(const std::vector<double>& params, const std::vector<double>& data) {
+MA::MA(const ModelRecord& record) {
+    this->restore(record);
+    this->maOrder = record.fit.thetas.size();
+    this->thetas = record.fit.thetas;
+    this->name = fmt::format("MA({}) Model", this->maOrder);
+}
+
+double getNLLMA(const double* params, const SeriesView& series, FitWorkspace& workspace) {
     double mu = params[0]; 
-    size_t count = data.size();
-    std::vector<double> maParams(params.begin() + 1, params.end());
-    size_t k = maParams.size(); 
-    std::vector<double> residuals(count, 0.0);
-    double sumResidualsSq = 0.0;
+    const double* data = series.data;
+    size_t count = series.count;
+    int k = series.q; // MA order
+    double* residuals = workspace.residuals.data();
+
+    // Reverse coefficients so theta_j lines up with e_{t-j} in the window [t-k, t)
+    double* lags = workspace.maLags.data();
+    for (int j = 0; j < k; ++j) {
+        lags[k - j - 1] = params[j + 1];
+    }
 
     // Get residuals for the first k points (no MA effect for the initial points)
-    for (size_t i = 0; i < k; ++i) {
+    double sumResidualsSq = 0.0;
+    for (int i = 0; i < k; ++i) {
         residuals[i] = data[i] - mu;  // Simple difference for initial residuals
         sumResidualsSq += residuals[i] * residuals[i];
     }
 
     // Calculate residuals for the rest of the data using MA model
     for (size_t i = k; i < count; ++i) {
-        double prediction = mu; 
-        for (size_t j = 0; j < k; ++j) {
-            prediction += maParams[j] * residuals[i - j - 1]; 
-        }
+        double prediction = mu + lagDot(lags, residuals + i - k, k);
         residuals[i] = data[i] - prediction;
         sumResidualsSq += residuals[i] * residuals[i];
     }
@@ -48,110 +58,95 @@ double getNLLMA(const std::vector<double>& params, const std::vector<double>& da
 
 // Wrapper for NLOpt
 double objFunctionMA(const std::vector<double>& x, std::vector<double>& grad, void *data) {
-    std::vector<double> *dataPtr = static_cast<std::vector<double>*>(data);
-    return getNLLMA(x, *dataPtr);
+    ObjectiveData* objective = static_cast<ObjectiveData*>(data);
+    return getNLLMA(x.data(), objective->series, *objective->workspace);
 }
 
-void MA::train(int maOrder) {
-    this->maOrder = maOrder;
-
-    nlopt::opt optimizer(nlopt::LN_COBYLA, maOrder+1);
-    optimizer.set_xtol_rel(1e-7);
-    optimizer.set_maxeval(20000);
+ModelFit fitMA(const double* data, size_t count, int maOrder, FitWorkspace& workspace, const ModelFit* warmStart) {
+    nlopt::opt& optimizer = workspace.getOptimizer(maOrder + 1, 1e-7, 20000);
+    SeriesView series = {data, count, 0, maOrder};
+    workspace.reserve(count, 0, maOrder);
 
-    // Get price vector
-    std::vector<double> dataVec;
-    for (const auto& [date, value] : this->data) {
-        dataVec.push_back(value);
+    std::vector<double>& x = workspace.x;
+    if (warmStart) {
+        warmStart->getParams(x);
+        if (x.size() != static_cast<size_t>(maOrder + 1)) {
+            throw std::invalid_argument("Could not fit MA model: warm start has the wrong order");
+        }
+    } else {
+        double sampleMean = std::accumulate(data, data + count, 0.0) / count;
+        x.assign(maOrder + 1, 0.1);
+        x[0] = sampleMean;  // Initialize mean parameter with sample mean
     }
 
-    double sampleMean = std::accumulate(dataVec.begin(), dataVec.end(), 0.0) / dataVec.size();
-    std::vector<double> x(maOrder+1, 0.1);
-    x[0] = sampleMean;  // Initialize mean parameter with sample mean
-    double minNLL;
-
+    ModelFit fit;
     try {
-        optimizer.set_min_objective(objFunctionMA, &dataVec);
-        optimizer.optimize(x, minNLL);
+        ObjectiveData objective = {series, &workspace};
+        optimizer.set_min_objective(objFunctionMA, &objective);
+        optimizer.optimize(x, fit.nll);
     } catch (const std::exception &e) {
         std::cerr << "nlopt failed: " << e.what() << std::endl;
     }
 
     // Save learnt parameters
-    this->c = x[0];
-    this->thetas.clear();
-    for (int i = 1; i < maOrder+1; ++i) {
-        this->thetas.push_back(x[i]);
-    }
-
-    // Get accuracy metrics 
-    Eigen::VectorXd labels(this->count - maOrder);
-    Eigen::VectorXd predictions(this->count - maOrder);
-    std::vector<double> residuals; 
-
-    // Set simple first maOrder residuals 
-    for (int i = 0; i < maOrder; ++i) {
-        residuals.push_back(dataVec[i] - this->c);
+    fit.c = x[0];
+    fit.thetas.assign(x.begin() + 1, x.end());
+
+    // Get accuracy metrics from residuals of the learnt parameters, skipping
+    // the simple first maOrder residuals
+    getNLLMA(x.data(), series, workspace);
+    double sumSq = 0.0;
+    double sumAbs = 0.0;
+    for (size_t i = maOrder; i < count; ++i) {
+        const double residual = workspace.residuals[i];
+        sumSq += residual * residual;
+        sumAbs += std::abs(residual);
     }
+    fit.mse = sumSq / (count - maOrder);
+    fit.rmse = std::sqrt(fit.mse);
+    fit.mae = sumAbs / (count - maOrder);
 
-    for (size_t i = maOrder; i < this->count; ++i) {
-        double prediction = this->c;
-        for (int j = 0; j < maOrder; ++j) {
-            prediction += this->thetas[j] * residuals[residuals.size() - j - 1];
-        }
-        residuals.push_back(dataVec[i] - prediction);
-        labels(i - maOrder) = dataVec[i];
-        predictions(i - maOrder) = prediction;
-    }
-
-    this->mse = (labels - predictions).squaredNorm() / (this->count - maOrder);
-    this->rmse = std::sqrt(this->mse);
-    this->mae = (labels - predictions).cwiseAbs().sum() / (this->count - maOrder);
-
-    // Set new name 
-    this->name = fmt::format("MA({}) Model", maOrder);
+    return fit;
 }
 
-void MA::forecast(int steps) {
-    this->forecasted.clear();
-    int k = this->maOrder;
-
-    std::time_t startDate = this->data.rbegin()->first + intervalToSeconds("1d");
+void MA::train(int maOrder) {
+    this->maOrder = maOrder;
 
+    // Get price vector
     std::vector<double> dataVec;
     for (const auto& [date, value] : this->data) {
         dataVec.push_back(value);
     }
 
-    // Get residuals for current learnt parameters
-    std::vector<double> residuals(this->count);
-    for (size_t i = k; i < this->count; ++i) {
-        double prediction = this->c;
+    FitWorkspace workspace;
+    ModelFit fit = fitMA(dataVec.data(), dataVec.size(), maOrder, workspace);
 
-        // Weighted sum of MA terms
-        for (int j = 0; j < k; ++j) {
-            prediction += this->thetas[j] * residuals[i - j - 1];
-        }
-        residuals[i] = dataVec[i] - prediction;
-    }
+    // Save learnt parameters and metrics
+    this->c = fit.c;
+    this->thetas = fit.thetas;
+    this->mse = fit.mse;
+    this->rmse = fit.rmse;
+    this->mae = fit.mae;
+    this->residuals = workspace.residuals;
+    this->state.reset(fit, dataVec.data(), this->residuals.data(), dataVec.size(), this->data.rbegin()->first);
 
-    // Forecast future values
-    for (int i = 0; i < steps; ++i) {
-        double forecast = this->c;
-        
-        // Sample a residual from the past residuals (bootstrapping)
-        double sampledResidual = residuals[rand() % this->count];
-        for (int j = 0; j < k; ++j) {
-            forecast += this->thetas[j] * residuals[this->count - k + i + j];
-        }
+    // Set new name 
+    this->name = fmt::format("MA({}) Model", maOrder);
+}
 
-        forecast += sampledResidual;
-        this->forecasted[startDate] = forecast;
-        startDate += intervalToSeconds("1d");
-        residuals.push_back(sampledResidual);
-    }
+ModelRecord MA::getRecord() const {
+    return this->makeRecord(ModelType::MA);
 }
 
+ModelFit MA::getFit() const {
+    ModelFit fit;
+    fit.c = this->c;
+    fit.thetas = this->thetas;
+    fit.mse = this->mse;
+    fit.rmse = this->rmse;
+    fit.mae = this->mae;
+    return fit;
+}
 
 std::vector<double> MA::getThetas() const {
     return this->thetas;
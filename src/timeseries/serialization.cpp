@@ -0,0 +1,293 @@
+#include "timeseries/serialization.hpp"
+#include "timeseries/timeseries_models.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+};
+
+struct RecordHeader {
+    std::uint32_t type;
+    std::int32_t arOrder;
+    std::int32_t maOrder;
+    std::uint32_t reserved;
+    std::int64_t lastDate;
+};
+
+static_assert(sizeof(FileHeader) == 16, "Model file header must be packed");
+static_assert(sizeof(RecordHeader) == 24, "Model record header must be packed");
+
+// Doubles stored after the record header: c, nll, mse, rmse, mae, then the
+// coefficients and final lags
+constexpr std::size_t RECORD_SCALARS = 5;
+
+std::size_t ModelRecord::getByteSize() const {
+    std::size_t doubles = RECORD_SCALARS + 2 * (fit.phis.size() + fit.thetas.size());
+    return sizeof(RecordHeader) + doubles * sizeof(double);
+}
+
+// Append a record to out
+static void encodeRecord(const ModelRecord& record, std::string& out) {
+    const int p = record.fit.phis.size();
+    const int q = record.fit.thetas.size();
+    if (record.values.size() != static_cast<std::size_t>(p) || record.residuals.size() != static_cast<std::size_t>(q)) {
+        throw std::invalid_argument("Could not save model: lag state does not match the model orders");
+    }
+
+    RecordHeader header = {static_cast<std::uint32_t>(record.type), p, q, 0, static_cast<std::int64_t>(record.lastDate)};
+    const double scalars[RECORD_SCALARS] = {record.fit.c, record.fit.nll, record.fit.mse, record.fit.rmse, record.fit.mae};
+
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(scalars), sizeof(scalars));
+    out.append(reinterpret_cast<const char*>(record.fit.phis.data()), p * sizeof(double));
+    out.append(reinterpret_cast<const char*>(record.fit.thetas.data()), q * sizeof(double));
+    out.append(reinterpret_cast<const char*>(record.values.data()), p * sizeof(double));
+    out.append(reinterpret_cast<const char*>(record.residuals.data()), q * sizeof(double));
+}
+
+// Check the file header of size bytes and return the record count
+static std::uint64_t decodeFileHeader(const char* bytes, std::size_t size) {
+    FileHeader header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("Could not load models: file is too short for a header");
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Could not load models: not a model file");
+    }
+    if (header.version != MODEL_FILE_VERSION) {
+        throw std::runtime_error(fmt::format("Could not load models: unsupported version {}", header.version));
+    }
+    if (header.count > (size - sizeof(header)) / sizeof(RecordHeader)) {
+        throw std::runtime_error("Could not load models: file is truncated");
+    }
+    return header.count;
+}
+
+// Decode the record starting at offset, or only validate it when record is
+// null, and return the offset of the next record
+static std::size_t decodeRecord(const char* bytes, std::size_t size, std::size_t offset, ModelRecord* record) {
+    RecordHeader header;
+    if (size - offset < sizeof(header)) {
+        throw std::runtime_error("Could not load models: file is truncated");
+    }
+    std::memcpy(&header, bytes + offset, sizeof(header));
+    if (header.type > static_cast<std::uint32_t>(ModelType::ARMA) || header.arOrder < 0 || header.maOrder < 0) {
+        throw std::runtime_error("Could not load models: corrupt record header");
+    }
+
+    const std::size_t p = header.arOrder;
+    const std::size_t q = header.maOrder;
+    const std::size_t doubles = RECORD_SCALARS + 2 * (p + q);
+    if ((size - offset - sizeof(header)) / sizeof(double) < doubles) {
+        throw std::runtime_error("Could not load models: file is truncated");
+    }
+    if (!record) {
+        return offset + sizeof(header) + doubles * sizeof(double);
+    }
+
+    const char* cursor = bytes + offset + sizeof(header);
+    auto read = [&cursor](double* out, std::size_t n) {
+        std::memcpy(out, cursor, n * sizeof(double));
+        cursor += n * sizeof(double);
+    };
+
+    double scalars[RECORD_SCALARS];
+    read(scalars, RECORD_SCALARS);
+    record->type = static_cast<ModelType>(header.type);
+    record->lastDate = static_cast<std::time_t>(header.lastDate);
+    record->fit.c = scalars[0];
+    record->fit.nll = scalars[1];
+    record->fit.mse = scalars[2];
+    record->fit.rmse = scalars[3];
+    record->fit.mae = scalars[4];
+    record->fit.phis.resize(p);
+    record->fit.thetas.resize(q);
+    record->values.resize(p);
+    record->residuals.resize(q);
+    read(record->fit.phis.data(), p);
+    read(record->fit.thetas.data(), q);
+    read(record->values.data(), p);
+    read(record->residuals.data(), q);
+
+    return cursor - bytes;
+}
+
+void writeModels(std::ostream& out, const std::vector<ModelRecord>& records) {
+    std::size_t byteSize = sizeof(FileHeader);
+    for (const auto& record : records) {
+        byteSize += record.getByteSize();
+    }
+
+    // Encode into one buffer so the stream sees a single write
+    std::string buffer;
+    buffer.reserve(byteSize);
+    FileHeader header;
+    std::memcpy(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic));
+    header.version = MODEL_FILE_VERSION;
+    header.count = records.size();
+    buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& record : records) {
+        encodeRecord(record, buffer);
+    }
+
+    out.write(buffer.data(), buffer.size());
+    if (!out) {
+        throw std::runtime_error("Could not save models: write failed");
+    }
+}
+
+std::vector<ModelRecord> readModels(std::istream& in) {
+    std::string buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::uint64_t count = decodeFileHeader(buffer.data(), buffer.size());
+
+    std::vector<ModelRecord> records;
+    std::size_t offset = sizeof(FileHeader);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        records.emplace_back();
+        offset = decodeRecord(buffer.data(), buffer.size(), offset, &records.back());
+    }
+    return records;
+}
+
+void saveModels(const std::string& path, const std::vector<std::shared_ptr<TimeSeriesModel>>& models) {
+    std::vector<ModelRecord> records;
+    records.reserve(models.size());
+    for (const auto& model : models) {
+        records.push_back(model->getRecord());
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file {}", path));
+    }
+    writeModels(file, records);
+}
+
+std::vector<std::shared_ptr<TimeSeriesModel>> loadModels(const std::string& path) {
+    return ModelStore(path).getModels();
+}
+
+std::shared_ptr<TimeSeriesModel> makeModel(const ModelRecord& record) {
+    switch (record.type) {
+        case ModelType::AR:   return std::make_shared<AR>(record);
+        case ModelType::MA:   return std::make_shared<MA>(record);
+        default:              return std::make_shared<ARMA>(record);
+    }
+}
+
+// Model persistence ----------------------------------------------------------
+void TimeSeriesModel::restore(const ModelRecord& record) {
+    this->count = 0;
+    this->c = record.fit.c;
+    this->mse = record.fit.mse;
+    this->rmse = record.fit.rmse;
+    this->mae = record.fit.mae;
+    this->state.reset(record.fit, record.values.data(), record.values.size(), record.residuals.data(), record.residuals.size(), record.lastDate);
+}
+
+ModelRecord TimeSeriesModel::makeRecord(ModelType type) const {
+    if (!this->state.ready) {
+        throw std::runtime_error("Could not save model: model is untrained");
+    }
+    ModelRecord record;
+    record.type = type;
+    record.fit = getFit();
+    record.values.assign(this->state.values.window(), this->state.values.window() + this->state.values.size());
+    record.residuals.assign(this->state.residuals.window(), this->state.residuals.window() + this->state.residuals.size());
+    record.lastDate = this->state.lastDate;
+    return record;
+}
+
+ModelRecord TimeSeriesModel::getRecord() const {
+    throw std::runtime_error(fmt::format("Could not save model: {} does not support serialization", this->name));
+}
+
+void TimeSeriesModel::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("Could not open file {}", path));
+    }
+    writeModels(file, {getRecord()});
+}
+
+std::shared_ptr<TimeSeriesModel> TimeSeriesModel::load(const std::string& path) {
+    ModelStore store(path);
+    if (store.size() != 1) {
+        throw std::runtime_error(fmt::format("Could not load model: {} holds {} models", path, store.size()));
+    }
+    return store.getModel(0);
+}
+
+// Model store ----------------------------------------------------------------
+ModelStore::ModelStore(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Could not open file {}", path));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(fd);
+        throw std::runtime_error(fmt::format("Could not load models: {} is too short for a header", path));
+    }
+
+    // The mapping outlives the descriptor
+    this->mappedSize = info.st_size;
+    void* mapped = ::mmap(nullptr, this->mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Could not map file {}", path));
+    }
+    this->mapped = static_cast<const char*>(mapped);
+
+    // Index records by walking their headers
+    try {
+        std::uint64_t count = decodeFileHeader(this->mapped, this->mappedSize);
+        this->offsets.reserve(count);
+        std::size_t offset = sizeof(FileHeader);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            this->offsets.push_back(offset);
+            offset = decodeRecord(this->mapped, this->mappedSize, offset, nullptr);
+        }
+    } catch (...) {
+        ::munmap(const_cast<char*>(this->mapped), this->mappedSize);
+        throw;
+    }
+}
+
+ModelStore::~ModelStore() {
+    ::munmap(const_cast<char*>(this->mapped), this->mappedSize);
+}
+
+ModelRecord ModelStore::getRecord(std::size_t i) const {
+    if (i >= size()) {
+        throw std::invalid_argument(fmt::format("Could not get model record: index {} out of range", i));
+    }
+    ModelRecord record;
+    decodeRecord(this->mapped, this->mappedSize, this->offsets[i], &record);
+    return record;
+}
+
+std::shared_ptr<TimeSeriesModel> ModelStore::getModel(std::size_t i) const {
+    return makeModel(getRecord(i));
+}
+
+std::vector<std::shared_ptr<TimeSeriesModel>> ModelStore::getModels() const {
+    std::vector<std::shared_ptr<TimeSeriesModel>> models;
+    models.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        models.push_back(getModel(i));
+    }
+    return models;
+}
@@ -0,0 +1,233 @@
+#include "timeseries/simulation.hpp"
+#include "timeseries/timeseries_models.hpp"
+#include "thread_utils.hpp"
+#include "random_utils.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+// Paths sharing a generator, and steps simulated before paths are reduced
+// to bands
+constexpr std::size_t PATH_BLOCK_SIZE = 256;
+constexpr int STEP_BLOCK_SIZE = 64;
+
+double getQuantile(std::vector<double>& values, double level) {
+    double position = level * (values.size() - 1);
+    std::size_t lower = static_cast<std::size_t>(position);
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    double lowerValue = values[lower];
+    if (lower + 1 >= values.size()) {
+        return lowerValue;
+    }
+    double upperValue = *std::min_element(values.begin() + lower + 1, values.end());
+    return lowerValue + (position - lower) * (upperValue - lowerValue);
+}
+
+// Shared path machinery. Each path keeps stateSize values, set by
+// init(state) and advanced by advance(state, step, shock), which returns the
+// simulated value at that step. Shocks are Gaussian with scale sigma or drawn
+// from the pool of in-sample residuals.
+template <typename Init, typename Advance>
+static SimulationResult runPaths(int steps,
+                                 const SimulationConfig& config,
+                                 double sigma,
+                                 const double* pool,
+                                 std::size_t poolSize,
+                                 std::size_t stateSize,
+                                 Init init,
+                                 Advance advance) {
+    const std::size_t pathCount = config.paths;
+    const std::size_t blockCount = (pathCount + PATH_BLOCK_SIZE - 1) / PATH_BLOCK_SIZE;
+
+    std::vector<double> state(pathCount * stateSize);
+    for (std::size_t path = 0; path < pathCount; ++path) {
+        init(state.data() + path * stateSize);
+    }
+
+    // One generator per block of paths keeps streams independent of threads
+    std::vector<Xoshiro256> generators;
+    std::vector<std::normal_distribution<double>> normals(blockCount);
+    for (std::size_t block = 0; block < blockCount; ++block) {
+        generators.emplace_back(config.seed, block);
+    }
+
+    SimulationResult result;
+    result.quantiles = config.quantiles;
+    result.mean.resize(steps);
+    result.bands.resize(steps, config.quantiles.size());
+    if (config.keepPaths) {
+        result.paths.resize(steps, pathCount);
+    }
+
+    // Paths advance a block of steps at a time, written straight into the
+    // result or into a scratch block reduced to bands before moving on
+    const int stepBlock = std::min(steps, STEP_BLOCK_SIZE);
+    Eigen::MatrixXd scratch;
+    if (!config.keepPaths) {
+        scratch.resize(stepBlock, pathCount);
+    }
+    Eigen::MatrixXd& block = config.keepPaths ? result.paths : scratch;
+
+    unsigned threadCount = getThreadCount(config.threadCount);
+    std::vector<std::vector<double>> rows(threadCount, std::vector<double>(pathCount));
+
+    for (int firstStep = 0; firstStep < steps; firstStep += stepBlock) {
+        const int blockSteps = std::min(stepBlock, steps - firstStep);
+        const int firstRow = config.keepPaths ? firstStep : 0;
+
+        // Advance every path through the step block
+        parallelFor(blockCount, threadCount, [&](std::size_t b, unsigned) {
+            Xoshiro256& rng = generators[b];
+            std::normal_distribution<double>& normal = normals[b];
+            std::uniform_int_distribution<std::size_t> index(0, poolSize - 1);
+
+            std::size_t lastPath = std::min(pathCount, (b + 1) * PATH_BLOCK_SIZE);
+            for (std::size_t path = b * PATH_BLOCK_SIZE; path < lastPath; ++path) {
+                double* values = state.data() + path * stateSize;
+                double* out = block.data() + path * block.rows() + firstRow;
+                for (int h = 0; h < blockSteps; ++h) {
+                    double shock = config.innovations == InnovationType::GAUSSIAN ? sigma * normal(rng) : pool[index(rng)];
+                    out[h] = advance(values, firstStep + h, shock);
+                }
+            }
+        });
+
+        // Reduce each simulated step to its mean and quantile bands
+        parallelFor(blockSteps, threadCount, [&](std::size_t h, unsigned worker) {
+            std::vector<double>& row = rows[worker];
+            double sum = 0.0;
+            for (std::size_t path = 0; path < pathCount; ++path) {
+                row[path] = block(firstRow + h, path);
+                sum += row[path];
+            }
+            result.mean[firstStep + h] = sum / pathCount;
+            for (std::size_t k = 0; k < config.quantiles.size(); ++k) {
+                result.bands(firstStep + h, k) = getQuantile(row, config.quantiles[k]);
+            }
+        });
+    }
+
+    return result;
+}
+
+static void checkSimulation(int steps, const SimulationConfig& config) {
+    if (steps < 1 || config.paths < 1) {
+        throw std::invalid_argument("Could not simulate paths: steps and path count must be positive");
+    }
+    for (const auto level : config.quantiles) {
+        if (level < 0 || level > 1) {
+            throw std::invalid_argument("Could not simulate paths: quantiles must be between 0 and 1");
+        }
+    }
+}
+
+SimulationResult simulatePaths(const ModelFit& fit,
+                               const double* data,
+                               const double* residuals,
+                               std::size_t count,
+                               int steps,
+                               const SimulationConfig& config,
+                               const std::vector<double>& tails) {
+    const int p = fit.phis.size();
+    const int q = fit.thetas.size();
+    const int d = tails.size();
+    const std::size_t start = std::max(p, q);
+    checkSimulation(steps, config);
+    if (count <= start) {
+        throw std::invalid_argument("Could not simulate paths: not enough data for the model order");
+    }
+
+    // Per path state, last p values then last q shocks, newest first, then
+    // the integration levels
+    auto init = [&](double* values) {
+        for (int j = 0; j < p; ++j) {
+            values[j] = data[count - j - 1];
+        }
+        for (int j = 0; j < q; ++j) {
+            values[p + j] = residuals[count - j - 1];
+        }
+        std::copy(tails.begin(), tails.end(), values + p + q);
+    };
+    auto advance = [&](double* values, int, double shock) {
+        double* shocks = values + p;
+        double* levels = shocks + q;
+        double x = fit.c + shock;
+        for (int j = 0; j < p; ++j) {
+            x += fit.phis[j] * values[j];
+        }
+        for (int j = 0; j < q; ++j) {
+            x += fit.thetas[j] * shocks[j];
+        }
+
+        // Shift lag windows
+        if (p > 0) {
+            std::copy_backward(values, values + p - 1, values + p);
+            values[0] = x;
+        }
+        if (q > 0) {
+            std::copy_backward(shocks, shocks + q - 1, shocks + q);
+            shocks[0] = shock;
+        }
+
+        // Integrate differenced values back to levels
+        for (int k = d - 1; k >= 0; --k) {
+            levels[k] += x;
+            x = levels[k];
+        }
+        return x;
+    };
+    return runPaths(steps, config, fit.rmse, residuals + start, count - start, p + q + d, init, advance);
+}
+
+SimulationResult simulateHoltWinters(const HoltWintersFit& fit,
+                                     const double* residuals,
+                                     std::size_t count,
+                                     int steps,
+                                     const SimulationConfig& config) {
+    const std::size_t period = std::max(fit.period, 0);
+    const std::size_t start = getHoltWintersStart(fit.period);
+    checkSimulation(steps, config);
+    if (count <= start) {
+        throw std::invalid_argument("Could not simulate paths: not enough data for the period");
+    }
+
+    // Per path state, level and trend then the seasonal ring, with the season
+    // of step h at h % period
+    auto init = [&](double* values) {
+        values[0] = fit.level;
+        values[1] = fit.trend;
+        std::copy(fit.seasonals.begin(), fit.seasonals.end(), values + 2);
+    };
+
+    // In error correction form the shock moves the level by alpha, the trend
+    // by alpha * beta and its season by (1 - alpha) * gamma
+    const double seasonalGain = (1.0 - fit.alpha) * fit.gamma;
+    auto advance = [&](double* values, int step, double shock) {
+        double& level = values[0];
+        double& trend = values[1];
+        double* season = period > 0 ? values + 2 + step % period : nullptr;
+        double x = level + trend + (season ? *season : 0.0) + shock;
+        level += trend + fit.alpha * shock;
+        trend += fit.alpha * fit.beta * shock;
+        if (season) {
+            *season += seasonalGain * shock;
+        }
+        return x;
+    };
+    return runPaths(steps, config, fit.rmse, residuals + start, count - start, 2 + period, init, advance);
+}
+
+SimulationResult TimeSeriesModel::simulate(int steps, const SimulationConfig& config) const {
+    if (this->count == 0) {
+        throw std::runtime_error("Could not simulate paths: model has no training history");
+    }
+    if (this->residuals.size() != this->count) {
+        throw std::runtime_error("Could not simulate paths: model must be trained first");
+    }
+    std::vector<double> dataVec;
+    for (const auto& [date, value] : this->data) {
+        dataVec.push_back(value);
+    }
+    return simulatePaths(getFit(), dataVec.data(), this->residuals.data(), dataVec.size(), steps, config);
+}
@@ -0,0 +1,249 @@
+#include "timeseries/validation.hpp"
+#include "timeseries/batch.hpp"
+#include "timeseries/simulation.hpp"
+#include "thread_utils.hpp"
+#include "random_utils.hpp"
+#include "print_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+// Write a fit as one row of [c, phi_1..phi_p, theta_1..theta_q]
+static void writeParams(const ModelFit& fit, double* row) {
+    row[0] = fit.c;
+    std::copy(fit.phis.begin(), fit.phis.end(), row + 1);
+    std::copy(fit.thetas.begin(), fit.thetas.end(), row + 1 + fit.phis.size());
+}
+
+// Column headers of a parameter row
+static std::vector<std::string> getParamNames(int arOrder, int maOrder) {
+    std::vector<std::string> names = {"const"};
+    for (int i = 0; i < arOrder; ++i) {
+        names.push_back(fmt::format("phi_{}", i + 1));
+    }
+    for (int i = 0; i < maOrder; ++i) {
+        names.push_back(fmt::format("theta_{}", i + 1));
+    }
+    return names;
+}
+
+CrossValidationResult crossValidate(const std::vector<double>& values,
+                                    ModelType type,
+                                    int arOrder,
+                                    int maOrder,
+                                    const CrossValidationConfig& config) {
+    auto [p, q] = getModelOrders(type, arOrder, maOrder);
+    if (p < 0 || q < 0) {
+        throw std::invalid_argument("Could not cross-validate: model orders must be non-negative");
+    }
+    if (config.folds < 1) {
+        throw std::invalid_argument("Could not cross-validate: folds must be positive");
+    }
+    const std::size_t n = values.size();
+    const std::size_t folds = config.folds;
+    const std::size_t blockSize = n / (folds + 1);
+    if (blockSize <= config.gap + std::max(p, q) + 1) {
+        throw std::invalid_argument("Could not cross-validate: blocks must exceed the gap and model order");
+    }
+
+    CrossValidationResult result;
+    result.type = type;
+    result.arOrder = p;
+    result.maOrder = q;
+    result.paramCount = 1 + p + q;
+    result.params.resize(folds * result.paramCount);
+    result.rmse.resize(folds);
+    result.mae.resize(folds);
+    for (std::size_t i = 0; i < folds; ++i) {
+        std::size_t testStart = (i + 1) * blockSize;
+        result.trainCounts.push_back(testStart - config.gap);
+        result.testStarts.push_back(testStart);
+        result.testCounts.push_back(i + 1 == folds ? n - testStart : blockSize);
+    }
+
+    // Every fold starts from the full sample estimate
+    FitWorkspace fullWorkspace;
+    ModelFit full = fitModel(type, values.data(), n, p, q, fullWorkspace);
+
+    std::vector<FitWorkspace> workspaces(getThreadCount(config.threadCount));
+    std::vector<double> sumSq(folds);
+    std::vector<double> sumAbs(folds);
+    parallelFor(folds, config.threadCount, [&](std::size_t i, unsigned worker) {
+        FitWorkspace& workspace = workspaces[worker];
+        ModelFit fit = fitModel(type, values.data(), result.trainCounts[i], p, q, workspace, &full);
+
+        // Residuals through the end of the test block are its one-step
+        // errors, made with the fold's parameters
+        const std::size_t testStart = result.testStarts[i];
+        const std::size_t testEnd = testStart + result.testCounts[i];
+        computeResiduals(type, fit, {values.data(), testEnd, p, q}, workspace);
+        for (std::size_t t = testStart; t < testEnd; ++t) {
+            const double error = workspace.residuals[t];
+            sumSq[i] += error * error;
+            sumAbs[i] += std::abs(error);
+        }
+
+        // Each worker writes disjoint rows
+        writeParams(fit, result.params.data() + i * result.paramCount);
+        result.rmse[i] = std::sqrt(sumSq[i] / result.testCounts[i]);
+        result.mae[i] = sumAbs[i] / result.testCounts[i];
+    });
+
+    std::size_t testTotal = n - result.testStarts.front();
+    result.pooledRMSE = std::sqrt(std::accumulate(sumSq.begin(), sumSq.end(), 0.0) / testTotal);
+    result.pooledMAE = std::accumulate(sumAbs.begin(), sumAbs.end(), 0.0) / testTotal;
+
+    return result;
+}
+
+std::string CrossValidationResult::toString() const {
+    std::vector<std::string> columnHeaders = {"Fold", "Train", "Test"};
+    std::vector<std::string> paramNames = getParamNames(arOrder, maOrder);
+    columnHeaders.insert(columnHeaders.end(), paramNames.begin(), paramNames.end());
+    columnHeaders.insert(columnHeaders.end(), {"RMSE", "MAE"});
+    std::vector<int> columnWidths(columnHeaders.size(), 10);
+
+    std::vector<std::vector<std::string>> tableData;
+    for (std::size_t i = 0; i < size(); ++i) {
+        std::vector<std::string> row = {fmt::format("{}", i + 1), fmt::format("{}", trainCounts[i]), fmt::format("{}", testCounts[i])};
+        const double* rowParams = getParams(i);
+        for (std::size_t j = 0; j < paramCount; ++j) {
+            row.push_back(fmt::format("{:.4f}", rowParams[j]));
+        }
+        row.push_back(fmt::format("{:.4f}", rmse[i]));
+        row.push_back(fmt::format("{:.4f}", mae[i]));
+        tableData.push_back(row);
+    }
+
+    return getTable(
+        fmt::format("{} Blocked Cross-Validation (RMSE {:.4f}, MAE {:.4f})", getModelName(type, arOrder, maOrder), pooledRMSE, pooledMAE),
+        tableData,
+        columnWidths,
+        columnHeaders,
+        false
+    );
+}
+
+BootstrapResult bootstrapParams(const std::vector<double>& values,
+                                ModelType type,
+                                int arOrder,
+                                int maOrder,
+                                const BootstrapConfig& config) {
+    auto [p, q] = getModelOrders(type, arOrder, maOrder);
+    if (p < 0 || q < 0) {
+        throw std::invalid_argument("Could not bootstrap: model orders must be non-negative");
+    }
+    if (config.replications < 2) {
+        throw std::invalid_argument("Could not bootstrap: at least 2 replications are required");
+    }
+    if (!(config.level > 0.0 && config.level < 1.0)) {
+        throw std::invalid_argument("Could not bootstrap: level must be in (0, 1)");
+    }
+    const std::size_t n = values.size();
+    const std::size_t start = std::max(p, q);
+    if (n <= start + 1) {
+        throw std::invalid_argument("Could not bootstrap: not enough data for the model order");
+    }
+    const std::size_t shockCount = n - start;
+    const std::size_t blockLength = config.blockLength ? config.blockLength : std::max<std::size_t>(1, std::lround(std::cbrt(shockCount)));
+    if (blockLength > shockCount) {
+        throw std::invalid_argument("Could not bootstrap: block length must not exceed the number of residuals");
+    }
+
+    BootstrapResult result;
+    result.type = type;
+    result.arOrder = p;
+    result.maOrder = q;
+    result.paramCount = 1 + p + q;
+    result.level = config.level;
+    result.params.resize(config.replications * result.paramCount);
+
+    FitWorkspace fullWorkspace;
+    result.estimate = fitModel(type, values.data(), n, p, q, fullWorkspace);
+    const ModelFit& estimate = result.estimate;
+
+    // Blocks are drawn from the centred residuals rather than the values, so
+    // joins between blocks do not break the dependence the model describes
+    std::vector<double> pool(fullWorkspace.residuals.begin() + start, fullWorkspace.residuals.end());
+    const double poolMean = std::accumulate(pool.begin(), pool.end(), 0.0) / shockCount;
+    for (double& shock : pool) {
+        shock -= poolMean;
+    }
+
+    // One shock and series buffer per worker, rebuilt for every replication
+    unsigned threadCount = getThreadCount(config.threadCount);
+    std::vector<FitWorkspace> workspaces(threadCount);
+    std::vector<std::vector<double>> shocks(threadCount, std::vector<double>(n, 0.0));
+    std::vector<std::vector<double>> resamples(threadCount, std::vector<double>(values.begin(), values.end()));
+    parallelFor(config.replications, config.threadCount, [&](std::size_t r, unsigned worker) {
+        Xoshiro256 rng(config.seed, r);
+        std::vector<double>& shock = shocks[worker];
+        const std::size_t startCount = shockCount - blockLength + 1;
+        for (std::size_t filled = 0; filled < shockCount; filled += blockLength) {
+            std::size_t first = static_cast<std::size_t>(rng.uniform() * startCount);
+            std::size_t length = std::min(blockLength, shockCount - filled);
+            std::copy(pool.begin() + first, pool.begin() + first + length, shock.begin() + start + filled);
+        }
+
+        // Rebuild the series through the fitted recursion from the original
+        // first values
+        std::vector<double>& resample = resamples[worker];
+        for (std::size_t t = start; t < n; ++t) {
+            double value = estimate.c + shock[t];
+            for (int j = 0; j < p; ++j) {
+                value += estimate.phis[j] * resample[t - j - 1];
+            }
+            for (int j = 0; j < q; ++j) {
+                value += estimate.thetas[j] * shock[t - j - 1];
+            }
+            resample[t] = value;
+        }
+
+        ModelFit fit = fitModel(type, resample.data(), n, p, q, workspaces[worker], &estimate);
+        writeParams(fit, result.params.data() + r * result.paramCount);
+    });
+
+    // Standard errors and percentile intervals per parameter
+    std::vector<double> column(config.replications);
+    for (std::size_t j = 0; j < result.paramCount; ++j) {
+        for (int r = 0; r < config.replications; ++r) {
+            column[r] = result.params[r * result.paramCount + j];
+        }
+        double mean = std::accumulate(column.begin(), column.end(), 0.0) / config.replications;
+        double sumSq = 0.0;
+        for (double value : column) {
+            sumSq += (value - mean) * (value - mean);
+        }
+        result.stdErr.push_back(std::sqrt(sumSq / (config.replications - 1)));
+        result.lower.push_back(getQuantile(column, 0.5 - 0.5 * config.level));
+        result.upper.push_back(getQuantile(column, 0.5 + 0.5 * config.level));
+    }
+
+    return result;
+}
+
+std::string BootstrapResult::toString() const {
+    std::vector<double> estimateParams;
+    estimate.getParams(estimateParams);
+    std::vector<std::string> paramNames = getParamNames(arOrder, maOrder);
+
+    std::vector<std::vector<std::string>> tableData;
+    for (std::size_t j = 0; j < paramCount; ++j) {
+        tableData.push_back({
+            paramNames[j],
+            fmt::format("{:.4f}", estimateParams[j]),
+            fmt::format("{:.4f}", stdErr[j]),
+            fmt::format("{:.4f}", lower[j]),
+            fmt::format("{:.4f}", upper[j])
+        });
+    }
+    return getTable(
+        fmt::format("{} Block Bootstrap ({} replications, {:.0f}% intervals)", getModelName(type, arOrder, maOrder), size(), 100 * level),
+        tableData,
+        {10, 12, 12, 12, 12},
+        {"Param", "Estimate", "Std Err", "Lower", "Upper"},
+        false
+    );
+}
@@ -0,0 +1,258 @@
+#include "timeseries/var.hpp"
+#include "print_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// Rows of the lag matrix built at a time, small enough for a block of
+// regressors to stay in cache while it is folded into the normal equations
+constexpr Eigen::Index VAR_BLOCK_ROWS = 256;
+
+VAR::VAR(const std::vector<TimeSeries<double>>& series, const std::vector<std::string>& names) {
+    if (series.empty()) {
+        throw std::invalid_argument("Could not create VAR model: at least one series is required");
+    }
+
+    // Walk every series once in date order, keeping the dates they all share
+    std::vector<TimeSeries<double>::const_iterator> its, ends;
+    for (const auto& s : series) {
+        its.push_back(s.begin());
+        ends.push_back(s.end());
+    }
+    std::vector<double> rows;
+    bool done = false;
+    while (!done) {
+        std::time_t date = 0;
+        for (std::size_t j = 0; j < series.size(); ++j) {
+            if (its[j] == ends[j]) {
+                done = true;
+                break;
+            }
+            date = std::max(date, its[j]->first);
+        }
+        if (done) {
+            break;
+        }
+
+        bool aligned = true;
+        for (std::size_t j = 0; j < series.size(); ++j) {
+            while (its[j] != ends[j] && its[j]->first < date) {
+                ++its[j];
+            }
+            if (its[j] == ends[j]) {
+                done = true;
+            }
+            aligned = aligned && !done && its[j]->first == date;
+        }
+        if (aligned) {
+            this->dates.push_back(date);
+            for (std::size_t j = 0; j < series.size(); ++j) {
+                rows.push_back((its[j]++)->second);
+            }
+        }
+    }
+
+    // Transpose the row-major walk into one contiguous column per series
+    this->values = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(
+        rows.data(), this->dates.size(), series.size());
+    this->spacing = getMedianSpacing(this->dates.data(), this->dates.size());
+    setNames(names);
+
+    // Mark model as untrained
+    this->lagOrder = -1;
+}
+
+VAR::VAR(const Eigen::MatrixXd& values, const std::vector<std::time_t>& dates, const std::vector<std::string>& names) {
+    if (values.cols() == 0) {
+        throw std::invalid_argument("Could not create VAR model: at least one series is required");
+    }
+    if (!dates.empty() && dates.size() != static_cast<std::size_t>(values.rows())) {
+        throw std::invalid_argument("Could not create VAR model: dates must match the number of observations");
+    }
+    this->values = values;
+    this->dates = dates;
+    this->spacing = getMedianSpacing(this->dates.data(), this->dates.size());
+    setNames(names);
+
+    // Mark model as untrained
+    this->lagOrder = -1;
+}
+
+void VAR::setNames(const std::vector<std::string>& names) {
+    if (!names.empty() && names.size() != getSeriesCount()) {
+        throw std::invalid_argument("Could not create VAR model: names must match the number of series");
+    }
+    this->names = names;
+    for (std::size_t j = names.size(); j < getSeriesCount(); ++j) {
+        this->names.push_back(fmt::format("y{}", j + 1));
+    }
+}
+
+void VAR::train(int lagOrder) {
+    const Eigen::Index n = this->values.rows();
+    const Eigen::Index k = this->values.cols();
+    const Eigen::Index m = 1 + k * lagOrder;
+    if (lagOrder < 1) {
+        throw std::invalid_argument("Could not train VAR model: lag order must be at least 1");
+    }
+    if (n - lagOrder <= m) {
+        throw std::invalid_argument("Could not train VAR model: not enough observations for the lag order and series count");
+    }
+    const Eigen::Index rows = n - lagOrder;
+
+    // Accumulate X'X and X'Y one block of rows at a time. Each lag block of a
+    // row block is a contiguous slice of every series column, copied whole.
+    Eigen::MatrixXd gram = Eigen::MatrixXd::Zero(m, m);
+    Eigen::MatrixXd moments = Eigen::MatrixXd::Zero(m, k);
+    Eigen::MatrixXd block(VAR_BLOCK_ROWS, m);
+    for (Eigen::Index start = 0; start < rows; start += VAR_BLOCK_ROWS) {
+        const Eigen::Index size = std::min(VAR_BLOCK_ROWS, rows - start);
+        auto x = block.topRows(size);
+        x.col(0).setOnes();
+        for (int lag = 1; lag <= lagOrder; ++lag) {
+            x.middleCols(1 + (lag - 1) * k, k) = this->values.block(start + lagOrder - lag, 0, size, k);
+        }
+        gram.selfadjointView<Eigen::Lower>().rankUpdate(x.transpose());
+        moments.noalias() += x.transpose() * this->values.block(start + lagOrder, 0, size, k);
+    }
+
+    // One solve for every equation, falling back to the minimum norm solution
+    // when series are collinear
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(gram.selfadjointView<Eigen::Lower>());
+    if (ldlt.info() == Eigen::Success && ldlt.rcond() > 1e-12) {
+        this->coefficients = ldlt.solve(moments);
+    } else {
+        Eigen::MatrixXd full = gram.selfadjointView<Eigen::Lower>();
+        this->coefficients = full.completeOrthogonalDecomposition().solve(moments);
+    }
+
+    // Residuals, again built block by block
+    this->residuals.resize(rows, k);
+    for (Eigen::Index start = 0; start < rows; start += VAR_BLOCK_ROWS) {
+        const Eigen::Index size = std::min(VAR_BLOCK_ROWS, rows - start);
+        auto fitted = this->residuals.middleRows(start, size);
+        fitted = this->values.block(start + lagOrder, 0, size, k);
+        fitted.rowwise() -= this->coefficients.row(0);
+        for (int lag = 1; lag <= lagOrder; ++lag) {
+            fitted.noalias() -= this->values.block(start + lagOrder - lag, 0, size, k)
+                              * this->coefficients.middleRows(1 + (lag - 1) * k, k);
+        }
+    }
+
+    // Residual covariance with a degrees of freedom correction, RMSE per equation
+    Eigen::MatrixXd sumSq = this->residuals.transpose() * this->residuals;
+    this->covariance = sumSq / static_cast<double>(rows - m);
+    this->rmse.resize(k);
+    for (Eigen::Index j = 0; j < k; ++j) {
+        this->rmse[j] = std::sqrt(sumSq(j, j) / rows);
+    }
+
+    this->lagOrder = lagOrder;
+}
+
+void VAR::forecast(int steps, double* out) const {
+    if (this->lagOrder < 1) {
+        throw std::runtime_error("Could not forecast: model must be trained first");
+    }
+    if (steps < 0) {
+        throw std::invalid_argument("Could not forecast: steps must be non-negative");
+    }
+    const Eigen::Index n = this->values.rows();
+    const Eigen::Index k = this->values.cols();
+    const Eigen::Index m = this->coefficients.rows();
+
+    // Regressor of the next step, 1 then the latest p observations newest first
+    Eigen::VectorXd z(m);
+    z(0) = 1.0;
+    for (int lag = 1; lag <= this->lagOrder; ++lag) {
+        z.segment(1 + (lag - 1) * k, k) = this->values.row(n - lag).transpose();
+    }
+
+    Eigen::Map<Eigen::MatrixXd> result(out, steps, k);
+    Eigen::VectorXd next(k);
+    for (int h = 0; h < steps; ++h) {
+        next.noalias() = this->coefficients.transpose() * z;
+        result.row(h) = next.transpose();
+
+        // Age every lag block by one step
+        std::memmove(z.data() + 1 + k, z.data() + 1, sizeof(double) * k * (this->lagOrder - 1));
+        z.segment(1, k) = next;
+    }
+}
+
+Eigen::MatrixXd VAR::forecast(int steps) const {
+    Eigen::MatrixXd result(std::max(steps, 0), this->values.cols());
+    forecast(steps, result.data());
+    return result;
+}
+
+TimeSeries<double> VAR::getForecasted(std::size_t series, int steps) const {
+    if (series >= getSeriesCount()) {
+        throw std::invalid_argument(fmt::format("Could not get forecast: series {} out of range", series));
+    }
+    if (this->dates.empty()) {
+        throw std::runtime_error("Could not get forecast: model has no dates");
+    }
+    Eigen::MatrixXd path = forecast(steps);
+    TimeSeries<double> forecasted;
+    std::time_t date = this->dates.back();
+    for (int h = 0; h < steps; ++h) {
+        date += this->spacing;
+        forecasted.emplace_hint(forecasted.end(), date, path(h, series));
+    }
+    return forecasted;
+}
+
+Eigen::VectorXd VAR::getIntercepts() const {
+    if (this->lagOrder < 1) {
+        throw std::runtime_error("Could not get intercepts: model must be trained first");
+    }
+    return this->coefficients.row(0).transpose();
+}
+
+Eigen::MatrixXd VAR::getLagMatrix(int lag) const {
+    if (this->lagOrder < 1) {
+        throw std::runtime_error("Could not get lag matrix: model must be trained first");
+    }
+    if (lag < 1 || lag > this->lagOrder) {
+        throw std::invalid_argument(fmt::format("Could not get lag matrix: lag {} out of range", lag));
+    }
+    const Eigen::Index k = this->values.cols();
+    return this->coefficients.middleRows(1 + (lag - 1) * k, k).transpose();
+}
+
+std::string VAR::toString() const {
+    const std::size_t k = getSeriesCount();
+    std::vector<std::string> columnHeaders = {""};
+    columnHeaders.insert(columnHeaders.end(), this->names.begin(), this->names.end());
+    std::vector<int> columnWidths(columnHeaders.size(), 12);
+
+    if (this->lagOrder < 1) {
+        return getTable(fmt::format("VAR Model of {} Series (Untrained)", k), {}, columnWidths, columnHeaders, false);
+    }
+
+    // One column per equation, one row per regressor
+    std::vector<std::vector<std::string>> tableData;
+    auto addRow = [&](const std::string& label, Eigen::Index row) {
+        std::vector<std::string> line = {label};
+        for (std::size_t i = 0; i < k; ++i) {
+            line.push_back(fmt::format("{:.4f}", this->coefficients(row, i)));
+        }
+        tableData.push_back(line);
+    };
+    addRow("const", 0);
+    for (int lag = 1; lag <= this->lagOrder; ++lag) {
+        for (std::size_t j = 0; j < k; ++j) {
+            addRow(fmt::format("{}.L{}", this->names[j], lag), 1 + (lag - 1) * k + j);
+        }
+    }
+    std::vector<std::string> line = {"RMSE"};
+    for (double value : this->rmse) {
+        line.push_back(fmt::format("{:.4f}", value));
+    }
+    tableData.push_back(line);
+
+    return getTable(fmt::format("VAR({}) Model of {} Series", this->lagOrder, k), tableData, columnWidths, columnHeaders, false);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+class ARTest : public testing::Test {
+protected:
+    ARTest() {
+        // AR(2) process whose constant jumps halfway through
+        std::mt19937 rng(11);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        double x1 = 25.0, x2 = 25.0;
+        for (int i = 0; i < 1000; ++i) {
+            double c = i < 500 ? 5.0 : 15.0;
+            double x = c + 0.5 * x1 + 0.3 * x2 + noise(rng);
+            values.push_back(x);
+            x2 = x1;
+            x1 = x;
+        }
+    }
+
+    // Series of the first n values with daily timestamps
+    TimeSeries<double> getSeries(size_t n) const {
+        TimeSeries<double> series;
+        for (size_t i = 0; i < n; ++i) {
+            series[i * 86400] = values[i];
+        }
+        return series;
+    }
+
+    std::vector<double> values;
+};
+
+TEST_F(ARTest, OnlineMatchesLeastSquares) {
+    AR ar(getSeries(300));
+    ar.train(2);
+    ar.enableOnline();
+    for (size_t i = 300; i < 450; ++i) {
+        ar.update(i * 86400, values[i]);
+    }
+
+    // Ordinary least squares on the first 450 values
+    Eigen::MatrixXd z(448, 3);
+    Eigen::VectorXd y(448);
+    for (size_t t = 2; t < 450; ++t) {
+        z.row(t - 2) << 1.0, values[t - 1], values[t - 2];
+        y(t - 2) = values[t];
+    }
+    Eigen::VectorXd expected = z.colPivHouseholderQr().solve(y);
+
+    EXPECT_NEAR(ar.getC(), expected(0), 1e-6);
+    EXPECT_NEAR(ar.getPhis()[0], expected(1), 1e-8);
+    EXPECT_NEAR(ar.getPhis()[1], expected(2), 1e-8);
+    EXPECT_NEAR(ar.getOneStepForecast(), expected(0) + expected(1) * values[449] + expected(2) * values[448], 1e-6);
+}
+
+TEST_F(ARTest, ForgettingFactorTracksChanges) {
+    AR ar(getSeries(400));
+    ar.train(2);
+    ar.enableOnline(0.97);
+    for (size_t i = 400; i < 1000; ++i) {
+        ar.update(i * 86400, values[i]);
+    }
+
+    // Long run mean c / (1 - phi_1 - phi_2) should move to the new regime
+    const auto& phis = ar.getPhis();
+    double mean = ar.getC() / (1 - phis[0] - phis[1]);
+    EXPECT_NEAR(mean, 75.0, 7.5);
+    EXPECT_GT(ar.getMSE(), 0.0);
+    EXPECT_NEAR(ar.getRMSE() * ar.getRMSE(), ar.getMSE(), 1e-9);
+
+    // The trimmed history stays aligned and ends at the latest update
+    ar.forecast(1);
+    EXPECT_EQ(ar.getForecasted().begin()->first, 1000 * 86400);
+    SimulationConfig config;
+    config.paths = 2000;
+    SimulationResult paths = ar.simulate(1, config);
+    EXPECT_NEAR(paths.mean[0], ar.getOneStepForecast(), 4.0 * ar.getRMSE() / std::sqrt(2000.0));
+}
+
+TEST_F(ARTest, InvalidOnlineUsage) {
+    AR ar(getSeries(100));
+    EXPECT_THROW(ar.enableOnline(), std::runtime_error);
+
+    ar.train(1);
+    EXPECT_THROW(ar.update(100 * 86400, 1.0), std::runtime_error);
+    EXPECT_THROW(ar.enableOnline(1.5), std::invalid_argument);
+
+    ar.enableOnline();
+    EXPECT_THROW(ar.update(0, 1.0), std::invalid_argument);
+}
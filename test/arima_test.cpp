@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+// Integrated AR(1) differences with drift
+TimeSeries<double> simulateARIMA(double c, double phi, int d, int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> values(count, 0.0);
+    double last = c / (1 - phi);
+    for (int t = 0; t < count; ++t) {
+        last = c + phi * last + noise(rng);
+        values[t] = last;
+    }
+    for (int k = 0; k < d; ++k) {
+        std::partial_sum(values.begin(), values.end(), values.begin());
+    }
+
+    TimeSeries<double> data;
+    for (int t = 0; t < count; ++t) {
+        data[86400 * t] = 100.0 + values[t];
+    }
+    return data;
+}
+
+TEST(ARIMATest, DifferencingRoundTrip) {
+    std::vector<double> values = {3, 5, 4, 8, 13, 11, 17};
+    std::vector<double> buffer = values;
+    std::vector<double> tails(2);
+    differenceInPlace(buffer.data(), buffer.size(), 2, tails.data());
+    EXPECT_EQ(tails[0], 17);
+    EXPECT_EQ(tails[1], 6);
+    EXPECT_EQ(std::vector<double>(buffer.begin() + 2, buffer.end()), std::vector<double>({-3, 5, 1, -7, 8}));
+
+    // Integrating the next second differences continues the series
+    std::vector<double> next = {1, -2};
+    integrateInPlace(next.data(), next.size(), 2, tails.data());
+    EXPECT_EQ(next, std::vector<double>({24, 29}));
+}
+
+TEST(ARIMATest, MatchesARMAWithoutDifferencing) {
+    TimeSeries<double> data = simulateARIMA(0.5, 0.6, 0, 300, 1);
+    ARMA arma(data);
+    ARIMA arima(data);
+    arma.train(1, 1);
+    arima.train(1, 0, 1);
+
+    arma.forecast(25);
+    arima.forecast(25);
+    EXPECT_EQ(arima.getForecasts(), arma.getForecasts());
+    EXPECT_EQ(arima.forecastIntervals(25).stdErr, arma.forecastIntervals(25).stdErr);
+}
+
+TEST(ARIMATest, IntegratedForecasts) {
+    TimeSeries<double> data = simulateARIMA(0.2, 0.5, 1, 3000, 2);
+    ARIMA arima(data);
+    EXPECT_THROW(arima.forecast(5), std::runtime_error);
+    EXPECT_THROW(arima.train(1, -1, 0), std::invalid_argument);
+    arima.train(1, 1, 0);
+    EXPECT_EQ(arima.getDiffOrder(), 1);
+    EXPECT_NEAR(arima.getPhis()[0], 0.5, 0.05);
+    EXPECT_NEAR(arima.getC(), 0.2, 0.05);
+
+    // Level forecasts are the last level plus the cumulated difference forecasts
+    std::vector<double> levels;
+    for (const auto& [date, value] : data) {
+        levels.push_back(value);
+    }
+    arima.forecast(50);
+    const std::vector<double>& forecasts = arima.getForecasts();
+    double level = levels.back();
+    double diff = levels.back() - levels[levels.size() - 2];
+    for (int h = 0; h < 50; ++h) {
+        diff = arima.getC() + arima.getPhis()[0] * diff;
+        level += diff;
+        EXPECT_NEAR(forecasts[h], level, 1e-9);
+    }
+
+    // Interval widths grow without bound for an integrated series
+    ForecastResult result = arima.forecastIntervals({1, 10, 100}, 0.95);
+    EXPECT_NEAR(result.mean[1], forecasts[9], 1e-9);
+    EXPECT_NEAR(result.stdErr[0], arima.getRMSE(), 1e-12);
+    EXPECT_GT(result.stdErr[2], 2.5 * result.stdErr[1]);
+
+    // Residual diagnostics skip the values lost to differencing
+    std::vector<double> acf = arima.getResidualACF(5);
+    for (int k = 1; k <= 5; ++k) {
+        EXPECT_LT(std::abs(acf[k]), 0.06);
+    }
+}
+
+TEST(ARIMATest, RandomWalkIntervalsAndPaths) {
+    TimeSeries<double> data = simulateARIMA(0.1, 0.0, 1, 2000, 3);
+    ARIMA arima(data);
+    arima.train(0, 1, 0);
+
+    // Random walk with drift: mean grows linearly, error sd with sqrt(h)
+    ForecastResult result = arima.forecastIntervals(40);
+    double last = data.rbegin()->second;
+    for (int h = 1; h <= 40; ++h) {
+        EXPECT_NEAR(result.mean[h - 1], last + h * arima.getC(), 1e-9);
+        EXPECT_NEAR(result.stdErr[h - 1], arima.getRMSE() * std::sqrt(h), 1e-9);
+    }
+
+    // Simulated level paths agree with the analytic moments
+    SimulationConfig config;
+    config.paths = 20000;
+    config.quantiles = {0.025, 0.975};
+    SimulationResult paths = arima.simulate(40, config);
+    for (int h : {1, 20, 40}) {
+        double sd = result.stdErr[h - 1];
+        EXPECT_NEAR(paths.mean[h - 1], result.mean[h - 1], 0.05 * sd);
+        EXPECT_NEAR(paths.bands(h - 1, 1) - paths.bands(h - 1, 0), result.upper[h - 1] - result.lower[h - 1], 0.05 * sd);
+    }
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+// Direct O(n * maxLag) sample autocorrelations
+std::vector<double> getDirectACF(const std::vector<double>& values, int maxLag) {
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    std::vector<double> acf(maxLag + 1, 0.0);
+    for (int k = 0; k <= maxLag; ++k) {
+        for (size_t t = k; t < values.size(); ++t) {
+            acf[k] += (values[t] - mean) * (values[t - k] - mean);
+        }
+    }
+    for (int k = maxLag; k >= 0; --k) {
+        acf[k] /= acf[0];
+    }
+    return acf;
+}
+
+std::vector<double> simulateAR(const std::vector<double>& phis, int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> values(count, 0.0);
+    for (int t = 0; t < count; ++t) {
+        values[t] = noise(rng);
+        for (size_t j = 0; j < phis.size() && j < static_cast<size_t>(t); ++j) {
+            values[t] += phis[j] * values[t - j - 1];
+        }
+    }
+    return values;
+}
+
+TEST(AutocorrelationTest, MatchesDirectACF) {
+    for (int count : {2, 7, 333, 1024}) {
+        std::vector<double> values = simulateAR({0.6}, count, count);
+        int maxLag = std::min(count - 1, 40);
+        std::vector<double> expected = getDirectACF(values, maxLag);
+        std::vector<double> acf = getACF(values, maxLag);
+        ASSERT_EQ(acf.size(), maxLag + 1);
+        for (int k = 0; k <= maxLag; ++k) {
+            EXPECT_NEAR(acf[k], expected[k], 1e-10) << "count " << count << " lag " << k;
+        }
+    }
+
+    // Constant series have no autocorrelation
+    std::vector<double> constant(50, 3.0);
+    EXPECT_EQ(getACF(constant, 5), std::vector<double>({1, 0, 0, 0, 0, 0}));
+
+    EXPECT_THROW(getACF(constant, 50), std::invalid_argument);
+    EXPECT_THROW(getACF(constant, -1), std::invalid_argument);
+    EXPECT_THROW(getPACF(std::vector<double>{}), std::invalid_argument);
+}
+
+TEST(AutocorrelationTest, DurbinLevinson) {
+    // Theoretical ACF of an AR(2) has PACF phi_2 at lag 2 and zero after
+    double phi1 = 0.5;
+    double phi2 = 0.3;
+    std::vector<double> acf(10);
+    acf[0] = 1.0;
+    acf[1] = phi1 / (1 - phi2);
+    for (int k = 2; k < 10; ++k) {
+        acf[k] = phi1 * acf[k - 1] + phi2 * acf[k - 2];
+    }
+    std::vector<double> pacf = getPACF(acf);
+    EXPECT_NEAR(pacf[0], 1.0, 1e-12);
+    EXPECT_NEAR(pacf[1], acf[1], 1e-12);
+    EXPECT_NEAR(pacf[2], phi2, 1e-12);
+    for (int k = 3; k < 10; ++k) {
+        EXPECT_NEAR(pacf[k], 0.0, 1e-12);
+    }
+
+    // Sample PACF cuts off after the AR order
+    std::vector<double> values = simulateAR({phi1, phi2}, 20000, 3);
+    std::vector<double> sample = getPACF(getACF(values, 10));
+    EXPECT_NEAR(sample[2], phi2, 0.03);
+    for (int k = 3; k <= 10; ++k) {
+        EXPECT_LT(std::abs(sample[k]), 0.03);
+    }
+}
+
+TEST(AutocorrelationTest, Batch) {
+    std::vector<std::vector<double>> series;
+    for (int i = 0; i < 12; ++i) {
+        series.push_back(simulateAR({0.1 * (i % 8)}, 200 + 37 * i, i));
+    }
+
+    CorrelationTable sequential = getCorrelations(series, 15, 1);
+    CorrelationTable parallel = getCorrelations(series, 15, 4);
+    ASSERT_EQ(parallel.size(), series.size());
+    EXPECT_EQ(parallel.acf, sequential.acf);
+    EXPECT_EQ(parallel.pacf, sequential.pacf);
+    for (size_t i = 0; i < series.size(); ++i) {
+        std::vector<double> acf = getACF(series[i], 15);
+        std::vector<double> pacf = getPACF(acf);
+        for (int k = 0; k <= 15; ++k) {
+            EXPECT_EQ(parallel.getACF(i)[k], acf[k]);
+            EXPECT_EQ(parallel.getPACF(i)[k], pacf[k]);
+        }
+        EXPECT_NEAR(parallel.getBound(i), 1.959964 / std::sqrt(series[i].size()), 1e-6);
+    }
+    EXPECT_FALSE(parallel.toString(3).empty());
+
+    series.push_back({1.0, 2.0});
+    EXPECT_THROW(getCorrelations(series, 15), std::invalid_argument);
+}
+
+TEST(AutocorrelationTest, ModelResiduals) {
+    std::vector<double> values = simulateAR({0.7}, 2000, 5);
+    TimeSeries<double> data;
+    for (size_t i = 0; i < values.size(); ++i) {
+        data[86400 * i] = values[i];
+    }
+
+    AR ar(data);
+    EXPECT_THROW(ar.getResidualACF(), std::runtime_error);
+    ar.train(1);
+
+    // Residuals of an adequate model are close to white noise
+    double bound = 3.0 / std::sqrt(values.size());
+    std::vector<double> acf = ar.getResidualACF(10);
+    std::vector<double> pacf = ar.getResidualPACF(10);
+    for (int k = 1; k <= 10; ++k) {
+        EXPECT_LT(std::abs(acf[k]), bound);
+        EXPECT_LT(std::abs(pacf[k]), bound);
+    }
+}
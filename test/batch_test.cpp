@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "timeseries/batch.hpp"
+
+#include <random>
+
+class BatchTest : public testing::Test {
+protected:
+    BatchTest() {
+        // Simulate AR(2) series with different lengths and constants
+        std::mt19937 rng(7);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        for (size_t s = 0; s < 12; ++s) {
+            std::vector<double> values;
+            double x1 = 50.0, x2 = 50.0;
+            for (size_t i = 0; i < 200 + 10 * s; ++i) {
+                double x = 10.0 + s + 0.5 * x1 + 0.3 * x2 + noise(rng);
+                values.push_back(x);
+                x2 = x1;
+                x1 = x;
+            }
+            series.push_back(values);
+        }
+    }
+
+    std::vector<std::vector<double>> series;
+};
+
+TEST_F(BatchTest, MatchesSequentialFits) {
+    auto table = fitBatch(series, ModelType::AR, 2, 0, 4);
+    ASSERT_EQ(table.size(), series.size());
+    EXPECT_EQ(table.paramCount, 3);
+
+    FitWorkspace workspace;
+    for (size_t i = 0; i < series.size(); ++i) {
+        ModelFit fit = fitAR(series[i].data(), series[i].size(), 2, workspace);
+        EXPECT_DOUBLE_EQ(table.getC(i), fit.c);
+        EXPECT_DOUBLE_EQ(table.getPhi(i, 1), fit.phis[0]);
+        EXPECT_DOUBLE_EQ(table.getPhi(i, 2), fit.phis[1]);
+        EXPECT_DOUBLE_EQ(table.mse[i], fit.mse);
+    }
+}
+
+TEST_F(BatchTest, ModelTypes) {
+    auto ma = fitBatch(series, ModelType::MA, 0, 2);
+    EXPECT_EQ(ma.arOrder, 0);
+    EXPECT_EQ(ma.maOrder, 2);
+    EXPECT_EQ(ma.params.size(), series.size() * 3);
+
+    auto arma = fitBatch(series, ModelType::ARMA, 1, 1);
+    EXPECT_EQ(arma.paramCount, 3);
+    for (size_t i = 0; i < arma.size(); ++i) {
+        EXPECT_TRUE(std::isfinite(arma.mse[i]));
+        EXPECT_NEAR(arma.rmse[i] * arma.rmse[i], arma.mse[i], 1e-9);
+    }
+    EXPECT_NO_THROW(arma.toString());
+}
+
+TEST_F(BatchTest, InvalidArguments) {
+    std::vector<double> values = {1, 2, 3, 4, 5};
+
+    // Offsets past the end of the buffer
+    EXPECT_THROW(
+        fitBatch(values, {0, 6}, ModelType::AR, 1),
+        std::invalid_argument
+    );
+
+    // Series shorter than the model order
+    EXPECT_THROW(
+        fitBatch(values, {0, 2, 5}, ModelType::AR, 2),
+        std::invalid_argument
+    );
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "data_provider.hpp"
+#include "priceseries.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+class DataProviderTest : public testing::Test {
+protected:
+    DataProviderTest() {
+        directory = std::filesystem::temp_directory_path() / "data_provider_test";
+        std::filesystem::create_directories(directory);
+        start = dateStringToEpoch("2020-01-01");
+        end = dateStringToEpoch("2020-04-10");
+    }
+
+    ~DataProviderTest() {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string getPath(const std::string& name) const {
+        return (directory / name).string();
+    }
+
+    std::filesystem::path directory;
+    std::time_t start;
+    std::time_t end;
+    SyntheticProvider synthetic{100.0, 0.001, 0.02, 7};
+};
+
+TEST_F(DataProviderTest, Synthetic) {
+    PriceData data = synthetic.fetch("AAA", start, end, "1d");
+    ASSERT_EQ(data.dates.size(), 100);
+    EXPECT_EQ(data.dates.front(), start);
+    EXPECT_EQ(data.dates[1] - data.dates[0], DAY_DURATION);
+    EXPECT_DOUBLE_EQ(data.opens.front(), 100.0);
+    for (std::size_t i = 0; i < data.dates.size(); ++i) {
+        EXPECT_GE(data.highs[i], std::max(data.opens[i], data.closes[i]));
+        EXPECT_LE(data.lows[i], std::min(data.opens[i], data.closes[i]));
+        EXPECT_GT(data.volumes[i], 0);
+    }
+
+    // Same arguments give the same bars, other tickers get their own
+    EXPECT_EQ(synthetic.fetch("AAA", start, end, "1d").closes, data.closes);
+    EXPECT_NE(synthetic.fetch("BBB", start, end, "1d").closes, data.closes);
+    EXPECT_THROW(synthetic.fetch("AAA", start, end, "xyz"), std::invalid_argument);
+}
+
+TEST_F(DataProviderTest, BinaryRoundTrip) {
+    PriceData data = synthetic.fetch("AAA", start, end, "1d");
+    writePriceData(getPath("AAA.bin"), data);
+
+    // Only the requested range is read back
+    BinaryProvider provider(directory.string());
+    PriceData slice = provider.fetch("AAA", data.dates[10], data.dates[30], "1d");
+    ASSERT_EQ(slice.dates.size(), 20);
+    for (std::size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(slice.dates[i], data.dates[10 + i]);
+        EXPECT_EQ(slice.opens[i], data.opens[10 + i]);
+        EXPECT_EQ(slice.highs[i], data.highs[10 + i]);
+        EXPECT_EQ(slice.lows[i], data.lows[10 + i]);
+        EXPECT_EQ(slice.closes[i], data.closes[10 + i]);
+        EXPECT_EQ(slice.adjCloses[i], data.adjCloses[10 + i]);
+        EXPECT_EQ(slice.volumes[i], data.volumes[10 + i]);
+    }
+    EXPECT_EQ(provider.fetch("AAA", start, end, "1d").closes, data.closes);
+    EXPECT_TRUE(provider.fetch("AAA", end, end + DAY_DURATION, "1d").dates.empty());
+
+    std::ofstream(getPath("bad.bin")) << "not a price file";
+    EXPECT_THROW(provider.fetch("bad", start, end, "1d"), std::runtime_error);
+    EXPECT_THROW(provider.fetch("missing", start, end, "1d"), std::runtime_error);
+}
+
+TEST_F(DataProviderTest, CSVRoundTrip) {
+    auto series = PriceSeries::getPriceSeries(synthetic, "AAA", start, end);
+    series->exportCSV(getPath("AAA.csv"));
+
+    CSVProvider provider(directory.string());
+    PriceData data = provider.fetch("AAA", start + 5 * DAY_DURATION, end, "1d");
+    ASSERT_EQ(data.dates.size(), 95);
+    const auto dates = series->getDates();
+    const auto closes = series->getCloses();
+    const auto volumes = series->getVolumes();
+    for (std::size_t i = 0; i < data.dates.size(); ++i) {
+        EXPECT_EQ(data.dates[i], dates[5 + i]);
+        EXPECT_NEAR(data.closes[i], closes[5 + i], 1e-3);
+        EXPECT_EQ(data.volumes[i], volumes[5 + i]);
+    }
+    EXPECT_THROW(provider.fetch("missing", start, end, "1d"), std::runtime_error);
+}
+
+TEST_F(DataProviderTest, DefaultProvider) {
+    auto previous = PriceSeries::getDataProvider();
+    PriceSeries::setDataProvider(std::make_shared<SyntheticProvider>(synthetic));
+
+    auto series = PriceSeries::getPriceSeries("AAA", "2020-01-01", "2020-04-10");
+    EXPECT_EQ(series->getCount(), 100);
+    EXPECT_EQ(series->getCloses(), synthetic.fetch("AAA", start, end, "1d").closes);
+
+    auto batch = PriceSeries::getPriceSeriesBatch({"AAA", "BBB"}, start, end, "1d",
+        [](PriceSeries& series) { series.addSMA(5); });
+    ASSERT_EQ(batch.size(), 2);
+    EXPECT_EQ(batch[1]->getCloses(), synthetic.fetch("BBB", start, end, "1d").closes);
+    EXPECT_EQ(batch[1]->getOverlays().size(), 1);
+
+    EXPECT_THROW(PriceSeries::setDataProvider(nullptr), std::invalid_argument);
+    PriceSeries::setDataProvider(previous);
+}
+
+TEST_F(DataProviderTest, Prefetch) {
+    std::vector<std::string> tickers = {"AAA", "BBB", "CCC", "DDD"};
+    Prefetcher prefetcher(std::make_shared<SyntheticProvider>(synthetic), 2);
+    prefetcher.prefetch(tickers, start, end);
+
+    for (const auto& ticker : tickers) {
+        auto series = prefetcher.get(ticker, start, end);
+        EXPECT_EQ(series->getTicker(), ticker);
+        EXPECT_EQ(series->getCloses(), synthetic.fetch(ticker, start, end, "1d").closes);
+    }
+
+    // Never prefetched, loaded on demand
+    EXPECT_EQ(prefetcher.get("EEE", "2020-01-01", "2020-01-11")->getCount(), 10);
+
+    // Load errors surface from get
+    Prefetcher missing(std::make_shared<BinaryProvider>(directory.string()), 1);
+    missing.prefetch("AAA", start, end);
+    EXPECT_THROW(missing.get("AAA", start, end), std::runtime_error);
+    EXPECT_THROW(missing.get("AAA", start, 0), std::invalid_argument);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "decimation.hpp"
+
+#include <cmath>
+
+TEST(DecimationTest, LTTB) {
+    std::vector<std::time_t> xs;
+    std::vector<double> ys;
+    for (int i = 0; i < 10000; ++i) {
+        xs.push_back(86400 * i);
+        ys.push_back(std::sin(0.01 * i));
+    }
+    // A single spike survives decimation
+    ys[5003] = 50.0;
+    ys[7001] = -50.0;
+
+    std::vector<std::size_t> indices = getLTTBIndices(xs, ys, 500);
+    ASSERT_EQ(indices.size(), 500);
+    EXPECT_EQ(indices.front(), 0);
+    EXPECT_EQ(indices.back(), 9999);
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_NE(std::find(indices.begin(), indices.end(), 5003), indices.end());
+    EXPECT_NE(std::find(indices.begin(), indices.end(), 7001), indices.end());
+
+    decimateLTTB(xs, ys, 500);
+    ASSERT_EQ(xs.size(), 500);
+    ASSERT_EQ(ys.size(), 500);
+    EXPECT_EQ(*std::max_element(ys.begin(), ys.end()), 50.0);
+    EXPECT_EQ(*std::min_element(ys.begin(), ys.end()), -50.0);
+
+    // Short lines are left as they are
+    std::vector<std::time_t> shortXs = {1, 2, 3};
+    std::vector<double> shortYs = {1.0, 3.0, 2.0};
+    decimateLTTB(shortXs, shortYs);
+    EXPECT_EQ(shortYs, std::vector<double>({1.0, 3.0, 2.0}));
+    EXPECT_EQ(getLTTBIndices(shortXs, shortYs, 2).size(), 3);
+}
+
+TEST(DecimationTest, OHLC) {
+    std::vector<std::time_t> dates;
+    std::vector<double> opens, highs, lows, closes;
+    std::vector<long> volumes;
+    for (int i = 0; i < 1000; ++i) {
+        dates.push_back(86400 * i);
+        opens.push_back(i);
+        highs.push_back(i + 1.0 + (i % 7));
+        lows.push_back(i - 1.0 - (i % 3));
+        closes.push_back(i + 0.5);
+        volumes.push_back(10 + i % 4);
+    }
+
+    OHLCBars bars = decimateOHLC(dates, opens, highs, lows, closes, volumes, 100);
+    ASSERT_EQ(bars.dates.size(), 100);
+    EXPECT_DOUBLE_EQ(bars.width, 10 * 86400);
+    for (std::size_t b = 0; b < 100; ++b) {
+        // Centred buckets tile the bars without overlapping
+        const std::size_t start = 10 * b;
+        EXPECT_EQ(bars.dates[b], dates[start] + 9 * 86400 / 2);
+        EXPECT_EQ(bars.dates[b] - bars.width / 2, dates[start] - 86400 / 2);
+        EXPECT_EQ(bars.opens[b], opens[start]);
+        EXPECT_EQ(bars.closes[b], closes[start + 9]);
+        EXPECT_EQ(bars.highs[b], *std::max_element(highs.begin() + start, highs.begin() + start + 10));
+        EXPECT_EQ(bars.lows[b], *std::min_element(lows.begin() + start, lows.begin() + start + 10));
+        EXPECT_EQ(bars.volumes[b], std::accumulate(volumes.begin() + start, volumes.begin() + start + 10, 0L));
+    }
+
+    // Few enough bars pass through with their own spacing as width
+    OHLCBars same = decimateOHLC(dates, opens, highs, lows, closes, volumes, 1000);
+    EXPECT_EQ(same.dates, dates);
+    EXPECT_EQ(same.closes, closes);
+    EXPECT_EQ(same.width, 86400.0);
+    std::vector<std::time_t> hours(dates.size());
+    for (std::size_t i = 0; i < hours.size(); ++i) {
+        hours[i] = 3600 * i;
+    }
+    EXPECT_EQ(decimateOHLC(hours, opens, highs, lows, closes, volumes, 1000).width, 3600.0);
+
+    EXPECT_THROW(decimateOHLC(dates, opens, highs, lows, closes, volumes, 0), std::invalid_argument);
+    closes.pop_back();
+    EXPECT_THROW(decimateOHLC(dates, opens, highs, lows, closes, volumes), std::invalid_argument);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "timeseries/evaluation.hpp"
+
+#include <random>
+
+class EvaluationTest : public testing::Test {
+protected:
+    EvaluationTest() {
+        // AR(1) process with unit noise
+        std::mt19937 rng(5);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        double x1 = 20.0;
+        for (int i = 0; i < 600; ++i) {
+            double x = 2.0 + 0.9 * x1 + noise(rng);
+            values.push_back(x);
+            x1 = x;
+        }
+    }
+
+    std::vector<double> values;
+};
+
+TEST_F(EvaluationTest, HorizonErrors) {
+    WalkForwardConfig config;
+    config.initialWindow = 300;
+    config.horizon = 5;
+    config.threadCount = 4;
+    auto result = walkForward(values, ModelType::AR, 1, 0, config);
+
+    ASSERT_EQ(result.rmse.size(), 5);
+    EXPECT_EQ(result.origins.size(), 300);
+    EXPECT_EQ(result.refits, 300);
+    for (size_t h = 0; h < 5; ++h) {
+        EXPECT_EQ(result.counts[h], 300 - h);
+    }
+
+    // One step errors are the noise, longer horizons accumulate it
+    EXPECT_NEAR(result.rmse[0], 1.0, 0.2);
+    EXPECT_GT(result.rmse[4], result.rmse[0]);
+    EXPECT_NO_THROW(result.toString());
+}
+
+TEST_F(EvaluationTest, RefitIntervalAndRollingWindow) {
+    WalkForwardConfig config;
+    config.initialWindow = 200;
+    config.horizon = 3;
+    config.refitEvery = 25;
+    config.step = 2;
+    config.expanding = false;
+    config.threadCount = 3;
+    auto result = walkForward(values, ModelType::ARMA, 1, 1, config);
+
+    EXPECT_EQ(result.origins.size(), 200);
+    EXPECT_EQ(result.refits, 8);
+    EXPECT_NEAR(result.rmse[0], 1.0, 0.3);
+
+    // Refitting at every origin with one thread gives the same scored counts
+    config.refitEvery = 1;
+    config.threadCount = 1;
+    auto sequential = walkForward(values, ModelType::ARMA, 1, 1, config);
+    EXPECT_EQ(sequential.counts, result.counts);
+    EXPECT_EQ(sequential.refits, 200);
+}
+
+TEST_F(EvaluationTest, InvalidArguments) {
+    WalkForwardConfig config;
+    config.initialWindow = 2;
+    EXPECT_THROW(walkForward(values, ModelType::AR, 3, 0, config), std::invalid_argument);
+
+    config.initialWindow = 100;
+    config.horizon = 0;
+    EXPECT_THROW(walkForward(values, ModelType::AR, 3, 0, config), std::invalid_argument);
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+TEST(ForecastingTest, LagBufferWindow) {
+    std::vector<double> values = {1, 2, 3, 4, 5};
+    LagBuffer buffer;
+    buffer.reset(values.data(), values.size(), 3);
+    ASSERT_EQ(buffer.size(), 3);
+    EXPECT_EQ(buffer.window()[0], 3);
+    EXPECT_EQ(buffer.window()[2], 5);
+
+    // Window stays contiguous and oldest first across wrap arounds
+    for (int i = 6; i < 12; ++i) {
+        buffer.push(i);
+        EXPECT_EQ(buffer.window()[0], i - 2);
+        EXPECT_EQ(buffer.window()[1], i - 1);
+        EXPECT_EQ(buffer.window()[2], i);
+        EXPECT_EQ(buffer.getLag(1), i);
+    }
+
+    // Short data is zero padded in front
+    LagBuffer padded;
+    padded.reset(values.data(), 2, 4);
+    EXPECT_EQ(padded.window()[0], 0);
+    EXPECT_EQ(padded.window()[1], 0);
+    EXPECT_EQ(padded.window()[2], 1);
+    EXPECT_EQ(padded.window()[3], 2);
+}
+
+TEST(ForecastingTest, MatchesFullHistoryForecast) {
+    ModelFit fit;
+    fit.c = 0.5;
+    fit.phis = {0.6, -0.2, 0.1};
+    fit.thetas = {0.4, 0.3};
+
+    std::mt19937 rng(4);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> data(300);
+    std::vector<double> residuals(300);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = noise(rng);
+        residuals[i] = noise(rng);
+    }
+
+    ForecastState state;
+    state.reset(fit, data.data(), residuals.data(), data.size(), 0);
+
+    std::vector<double> expected(50);
+    std::vector<double> forecasts(50);
+    forecastFit(fit, data.data(), residuals.data(), data.size(), 50, expected.data());
+    state.forecast(50, forecasts.data());
+    for (int h = 0; h < 50; ++h) {
+        EXPECT_NEAR(forecasts[h], expected[h], 1e-12);
+    }
+
+    // Pushing a new observation matches forecasting from the longer history
+    data.push_back(1.5);
+    residuals.push_back(-0.25);
+    state.push(86400, 1.5, -0.25);
+    forecastFit(fit, data.data(), residuals.data(), data.size(), 50, expected.data());
+    state.forecast(50, forecasts.data());
+    for (int h = 0; h < 50; ++h) {
+        EXPECT_NEAR(forecasts[h], expected[h], 1e-12);
+    }
+    EXPECT_EQ(state.lastDate, 86400);
+}
+
+TEST(ForecastingTest, ModelForecasts) {
+    std::mt19937 rng(8);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    TimeSeries<double> data;
+    double last = 0.0;
+    for (int i = 0; i < 300; ++i) {
+        last = 1.0 + 0.7 * last + noise(rng);
+        data[86400 * i] = last;
+    }
+
+    ARMA arma(data);
+    EXPECT_THROW(arma.forecast(5), std::runtime_error);
+    arma.train(2, 1);
+
+    // Repeated forecasts are deterministic and match the cached state
+    arma.forecast(20);
+    std::vector<double> first = arma.getForecasts();
+    arma.forecast(20);
+    ASSERT_EQ(arma.getForecasts(), first);
+
+    std::vector<double> dataVec;
+    for (const auto& [date, value] : data) {
+        dataVec.push_back(value);
+    }
+    std::vector<double> expected(20);
+    ModelFit fit = arma.getFit();
+    FitWorkspace workspace;
+    computeResiduals(ModelType::ARMA, fit, {dataVec.data(), dataVec.size(), 2, 1}, workspace);
+    forecastFit(fit, dataVec.data(), workspace.residuals.data(), dataVec.size(), 20, expected.data());
+    for (int h = 0; h < 20; ++h) {
+        EXPECT_NEAR(first[h], expected[h], 1e-9);
+    }
+
+    // Dated forecasts follow the last observation daily
+    TimeSeries<double> dated = arma.getForecasted();
+    ASSERT_EQ(dated.size(), 20);
+    EXPECT_EQ(dated.begin()->first, 86400 * 300);
+    EXPECT_EQ(dated.rbegin()->first, 86400 * 319);
+}
+
+TEST(ForecastingTest, PsiWeights) {
+    std::vector<double> psi(10);
+    getPsiWeights({0.5}, {}, 10, psi.data());
+    for (int j = 0; j < 10; ++j) {
+        EXPECT_NEAR(psi[j], std::pow(0.5, j), 1e-15);
+    }
+
+    // ARMA(1, 1): psi_j = phi^(j-1) * (phi + theta)
+    getPsiWeights({0.5}, {0.3}, 10, psi.data());
+    EXPECT_EQ(psi[0], 1.0);
+    for (int j = 1; j < 10; ++j) {
+        EXPECT_NEAR(psi[j], std::pow(0.5, j - 1) * 0.8, 1e-15);
+    }
+
+    EXPECT_NEAR(getNormalQuantile(0.975), 1.959963985, 1e-8);
+    EXPECT_NEAR(getNormalQuantile(0.005), -2.575829304, 1e-8);
+    EXPECT_NEAR(getNormalQuantile(0.5), 0.0, 1e-12);
+}
+
+TEST(ForecastingTest, HorizonIntervals) {
+    ModelFit fit;
+    fit.c = 0.5;
+    fit.phis = {0.6, -0.2, 0.1};
+    fit.thetas = {0.4, 0.3};
+
+    std::vector<double> data = {1.0, 2.0, 0.5, -0.3, 1.2};
+    std::vector<double> residuals = {0.0, 0.0, 0.1, -0.4, 0.2};
+    ForecastState state;
+    state.reset(fit, data.data(), residuals.data(), data.size(), 0);
+
+    std::vector<double> path(300);
+    std::vector<double> psi(300);
+    state.forecast(300, path.data());
+    getPsiWeights(fit.phis, fit.thetas, 300, psi.data());
+
+    // Horizons in any order match the recursive path and psi-weight sums
+    std::vector<int> horizons = {7, 1, 300, 2, 45, 3, 46};
+    ForecastResult result = state.forecast(horizons, 2.0, 0.9);
+    ASSERT_EQ(result.size(), horizons.size());
+    for (size_t k = 0; k < horizons.size(); ++k) {
+        int h = horizons[k];
+        double sumPsiSq = 0.0;
+        for (int j = 0; j < h; ++j) {
+            sumPsiSq += psi[j] * psi[j];
+        }
+        EXPECT_NEAR(result.mean[k], path[h - 1], 1e-10) << "horizon " << h;
+        EXPECT_NEAR(result.stdErr[k], 2.0 * std::sqrt(sumPsiSq), 1e-10) << "horizon " << h;
+        EXPECT_NEAR(result.upper[k] - result.mean[k], getNormalQuantile(0.95) * result.stdErr[k], 1e-10);
+        EXPECT_NEAR(result.mean[k] - result.lower[k], getNormalQuantile(0.95) * result.stdErr[k], 1e-10);
+    }
+
+    EXPECT_THROW(state.forecast({0}, 1.0), std::invalid_argument);
+    EXPECT_THROW(state.forecast({1}, 1.0, 1.0), std::invalid_argument);
+    EXPECT_EQ(state.forecast(std::vector<int>{}, 1.0).size(), 0);
+}
+
+TEST(ForecastingTest, LongHorizonAR) {
+    // AR(1) forecasts converge to the unconditional mean and variance
+    ModelFit fit;
+    fit.c = 1.0;
+    fit.phis = {0.9};
+    std::vector<double> data = {25.0};
+    std::vector<double> residuals = {0.0};
+    ForecastState state;
+    state.reset(fit, data.data(), residuals.data(), data.size(), 0);
+
+    ForecastResult result = state.forecast({1, 1000000}, 1.0);
+    EXPECT_NEAR(result.mean[0], 23.5, 1e-12);
+    EXPECT_NEAR(result.stdErr[0], 1.0, 1e-12);
+    EXPECT_NEAR(result.mean[1], 10.0, 1e-9);
+    EXPECT_NEAR(result.stdErr[1], 1.0 / std::sqrt(1 - 0.81), 1e-9);
+}
+
+TEST(ForecastingTest, IntervalsWithoutARTerms) {
+    // Past the MA order the mean settles on the constant
+    ModelRecord ma;
+    ma.type = ModelType::MA;
+    ma.fit.c = 5.0;
+    ma.fit.thetas = {0.4, -0.3};
+    ma.fit.rmse = 1.0;
+    ma.residuals = {0.5, -1.0};
+
+    ModelRecord constant;
+    constant.type = ModelType::ARMA;
+    constant.fit.c = 7.0;
+    constant.fit.rmse = 1.0;
+
+    for (const auto& record : {ma, constant}) {
+        auto model = makeModel(record);
+        model->forecast(10);
+        ForecastResult result = model->forecastIntervals(10);
+        ASSERT_EQ(result.size(), 10);
+        for (int h = 0; h < 10; ++h) {
+            EXPECT_NEAR(result.mean[h], model->getForecasts()[h], 1e-12) << "horizon " << h + 1;
+        }
+        EXPECT_EQ(result.mean.back(), record.fit.c);
+    }
+
+    // GARCH with an AR(0) mean uses the same intervals
+    std::mt19937 rng(6);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    TimeSeries<double> data;
+    for (int i = 0; i < 300; ++i) {
+        data[86400 * i] = 2.0 + noise(rng);
+    }
+    GARCH garch(data);
+    garch.train(0, 0);
+    garch.forecast(5);
+    ForecastResult result = garch.forecastIntervals(5);
+    for (int h = 0; h < 5; ++h) {
+        EXPECT_NEAR(result.mean[h], garch.getForecasts()[h], 1e-12) << "horizon " << h + 1;
+        EXPECT_NEAR(result.mean[h], garch.getC(), 1e-12);
+    }
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+// Simulate an AR(1)-GARCH(1, 1) process
+std::vector<double> simulateGARCH(double c, double phi, double omega, double alpha, double beta, int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    std::vector<double> values;
+    double variance = omega / (1.0 - alpha - beta);
+    double shock = 0.0;
+    double last = c / (1.0 - phi);
+    for (int t = 0; t < count; ++t) {
+        variance = omega + alpha * shock * shock + beta * variance;
+        shock = std::sqrt(variance) * noise(rng);
+        last = c + phi * last + shock;
+        values.push_back(last);
+    }
+    return values;
+}
+
+TEST(GARCHTest, AnalyticGradient) {
+    std::vector<double> values = simulateGARCH(0.1, 0.3, 0.1, 0.1, 0.8, 300, 3);
+    GARCHWorkspace workspace;
+    workspace.reserve(values.size(), 1, 1);
+    workspace.backcast = 1.0;
+    SeriesView series = {values.data(), values.size(), 1, 1};
+
+    std::vector<double> params = {0.05, 0.25, 0.1, 0.2, 0.15, 0.7};
+    std::vector<double> grad(params.size());
+    getNLLGARCH(params.data(), series, workspace, grad.data());
+
+    // Central differences
+    for (size_t k = 0; k < params.size(); ++k) {
+        const double h = 1e-6;
+        std::vector<double> up = params;
+        std::vector<double> down = params;
+        up[k] += h;
+        down[k] -= h;
+        double numeric = (getNLLGARCH(up.data(), series, workspace, nullptr) - getNLLGARCH(down.data(), series, workspace, nullptr)) / (2 * h);
+        EXPECT_NEAR(grad[k], numeric, 1e-4 * std::max(1.0, std::abs(numeric))) << "param " << k;
+    }
+}
+
+TEST(GARCHTest, RecoversParameters) {
+    std::vector<double> values = simulateGARCH(0.0, 0.0, 0.1, 0.1, 0.8, 5000, 11);
+    GARCHWorkspace workspace;
+    GARCHFit fit = fitGARCH(values.data(), values.size(), 0, 0, workspace);
+
+    EXPECT_NEAR(fit.mean.c, 0.0, 0.05);
+    EXPECT_NEAR(fit.alpha, 0.1, 0.04);
+    EXPECT_NEAR(fit.beta, 0.8, 0.08);
+    EXPECT_NEAR(fit.omega / (1.0 - fit.alpha - fit.beta), 1.0, 0.25);
+    EXPECT_LT(fit.alpha + fit.beta, 1.0);
+}
+
+TEST(GARCHTest, JointARMAFit) {
+    std::vector<double> values = simulateGARCH(0.2, 0.5, 0.05, 0.1, 0.85, 5000, 5);
+    GARCHWorkspace workspace;
+    GARCHFit fit = fitGARCH(values.data(), values.size(), 1, 0, workspace);
+
+    EXPECT_NEAR(fit.mean.c, 0.2, 0.05);
+    ASSERT_EQ(fit.mean.phis.size(), 1);
+    EXPECT_NEAR(fit.mean.phis[0], 0.5, 0.05);
+    EXPECT_NEAR(fit.alpha, 0.1, 0.04);
+    EXPECT_NEAR(fit.beta, 0.85, 0.06);
+
+    // Warm started refit on the same data stays at the optimum
+    GARCHFit refit = fitGARCH(values.data(), values.size(), 1, 0, workspace, &fit);
+    EXPECT_LE(refit.mean.nll, fit.mean.nll + 1e-6);
+
+    GARCHFit wrongOrder;
+    EXPECT_THROW(fitGARCH(values.data(), values.size(), 2, 0, workspace, &wrongOrder), std::invalid_argument);
+}
+
+TEST(GARCHTest, VarianceForecast) {
+    std::vector<double> values = simulateGARCH(0.0, 0.0, 0.1, 0.1, 0.8, 2000, 21);
+    TimeSeries<double> data;
+    for (size_t i = 0; i < values.size(); ++i) {
+        data[86400 * i] = values[i];
+    }
+
+    GARCH garch(data);
+    EXPECT_THROW(garch.forecastVariance(5), std::runtime_error);
+    garch.train();
+
+    ASSERT_EQ(garch.getVariances().size(), values.size());
+    std::vector<double> variances = garch.forecastVariance(500);
+    ASSERT_EQ(variances.size(), 500);
+
+    // Forecasts decay geometrically to the long-run variance
+    double longRun = garch.getOmega() / (1.0 - garch.getAlpha() - garch.getBeta());
+    EXPECT_NEAR(variances.back(), longRun, 1e-3 * longRun);
+    for (size_t i = 1; i < variances.size(); ++i) {
+        EXPECT_LE(std::abs(variances[i] - longRun), std::abs(variances[i - 1] - longRun) + 1e-12);
+    }
+
+    garch.forecast(3);
+    EXPECT_EQ(garch.getForecasted().size(), 3);
+}
+
+TEST(GARCHTest, ConditionalIntervals) {
+    std::vector<double> values = simulateGARCH(0.1, 0.5, 0.1, 0.15, 0.8, 2000, 8);
+    TimeSeries<double> data;
+    for (size_t i = 0; i < values.size(); ++i) {
+        data[86400 * i] = values[i];
+    }
+
+    GARCH garch(data);
+    garch.train(1, 0);
+    std::vector<double> variances = garch.forecastVariance(50);
+    std::vector<double> psi(50);
+    getPsiWeights(garch.getPhis(), garch.getThetas(), 50, psi.data());
+
+    // Widths follow the variance path, not the constant in-sample RMSE
+    ForecastResult result = garch.forecastIntervals({50, 1, 10});
+    EXPECT_NEAR(result.stdErr[1], std::sqrt(variances[0]), 1e-12);
+    for (std::size_t k = 0; k < result.size(); ++k) {
+        const int h = result.horizons[k];
+        double variance = 0.0;
+        for (int j = 0; j < h; ++j) {
+            variance += psi[j] * psi[j] * variances[h - j - 1];
+        }
+        EXPECT_NEAR(result.stdErr[k], std::sqrt(variance), 1e-9) << "horizon " << h;
+        EXPECT_NEAR(result.upper[k] - result.mean[k], result.mean[k] - result.lower[k], 1e-9);
+    }
+    EXPECT_NE(result.stdErr[1], garch.getRMSE());
+
+    // With a constant mean each step's error is its own conditional variance
+    GARCH pure(data);
+    pure.train();
+    std::vector<double> pureVariances = pure.forecastVariance(20);
+    ForecastResult pureResult = pure.forecastIntervals(20);
+    for (int h = 0; h < 20; ++h) {
+        EXPECT_NEAR(pureResult.stdErr[h], std::sqrt(pureVariances[h]), 1e-12);
+    }
+    EXPECT_NE(pureResult.stdErr.front(), pureResult.stdErr.back());
+}
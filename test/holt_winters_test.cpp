@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+class HoltWintersTest : public testing::Test {
+protected:
+    HoltWintersTest() {
+        // Trend plus a weekly season and noise
+        std::mt19937 rng(38);
+        std::normal_distribution<double> noise(0.0, 0.5);
+        for (int i = 0; i < 700; ++i) {
+            double value = 100.0 + 0.2 * i + pattern[i % 7] + noise(rng);
+            data[86400 * i] = value;
+            values.push_back(value);
+        }
+    }
+
+    double pattern[7] = {3.0, 1.0, -2.0, -4.0, 0.0, 2.0, 0.0};
+    TimeSeries<double> data;
+    std::vector<double> values;
+};
+
+TEST_F(HoltWintersTest, KernelMatchesRecursion) {
+    // Classic textbook recursion with separate level, trend and season arrays
+    const int m = 7;
+    double params[3] = {0.3, 0.1, 0.2};
+    const size_t n = values.size();
+    std::vector<double> level(n), trend(n), season(n);
+    double first = 0.0, second = 0.0;
+    for (int i = 0; i < m; ++i) {
+        first += values[i] / m;
+        second += values[m + i] / m;
+    }
+    level[m - 1] = first;
+    trend[m - 1] = (second - first) / m;
+    for (int i = 0; i < m; ++i) {
+        season[i] = values[i] - first;
+    }
+    double sse = 0.0;
+    for (size_t t = m; t < n; ++t) {
+        double error = values[t] - (level[t - 1] + trend[t - 1] + season[t - m]);
+        sse += error * error;
+        level[t] = params[0] * (values[t] - season[t - m]) + (1 - params[0]) * (level[t - 1] + trend[t - 1]);
+        trend[t] = params[1] * (level[t] - level[t - 1]) + (1 - params[1]) * trend[t - 1];
+        season[t] = params[2] * (values[t] - level[t]) + (1 - params[2]) * season[t - m];
+    }
+
+    HoltWintersFit fit;
+    fit.period = m;
+    std::vector<double> residuals(n);
+    EXPECT_NEAR(getSSEHoltWinters(values.data(), n, params, fit, residuals.data()), sse, 1e-8);
+    EXPECT_NEAR(fit.level, level[n - 1], 1e-10);
+    EXPECT_NEAR(fit.trend, trend[n - 1], 1e-10);
+    for (int i = 0; i < m; ++i) {
+        EXPECT_NEAR(fit.seasonals[i], season[n - m + i], 1e-10);
+    }
+    EXPECT_EQ(residuals[m - 1], 0.0);
+    EXPECT_NEAR(fit.mse, sse / (n - m), 1e-10);
+}
+
+TEST_F(HoltWintersTest, Seasonal) {
+    HoltWinters model(data);
+    model.train(7);
+    EXPECT_EQ(model.getPeriod(), 7);
+    EXPECT_NEAR(model.getRMSE(), 0.5, 0.1);
+    EXPECT_NEAR(model.getTrend(), 0.2, 0.05);
+
+    // Parameters beat every coarse grid point
+    HoltWintersFit fit = model.getHoltWintersFit();
+    HoltWintersFit scratch;
+    scratch.period = 7;
+    for (double alpha : {0.05, 0.25, 0.45, 0.85}) {
+        for (double gamma : {0.05, 0.45, 0.95}) {
+            double params[3] = {alpha, 0.05, gamma};
+            EXPECT_LE(fit.sse, getSSEHoltWinters(values.data(), values.size(), params, scratch) + 1e-9);
+        }
+    }
+
+    // Forecasts continue the trend and season
+    model.forecast(14);
+    const auto& forecasts = model.getForecasts();
+    ASSERT_EQ(forecasts.size(), 14);
+    for (int h = 0; h < 14; ++h) {
+        int i = 700 + h;
+        EXPECT_NEAR(forecasts[h], 100.0 + 0.2 * i + pattern[i % 7], 1.5);
+    }
+    EXPECT_EQ(model.getForecasted().begin()->first, 86400 * 700);
+
+    // Intervals widen with the horizon around the point forecasts
+    ForecastResult result = model.forecastIntervals(14);
+    EXPECT_NEAR(result.stdErr[0], model.getRMSE(), 1e-12);
+    for (int h = 1; h < 14; ++h) {
+        EXPECT_GT(result.stdErr[h], result.stdErr[h - 1]);
+        EXPECT_EQ(result.mean[h], forecasts[h]);
+    }
+    EXPECT_NE(model.toString().find("gamma"), std::string::npos);
+}
+
+TEST_F(HoltWintersTest, LinearTrend) {
+    TimeSeries<double> line;
+    for (int i = 0; i < 100; ++i) {
+        line[86400 * i] = 5.0 + 2.0 * i;
+    }
+    HoltWinters model(line);
+    model.train();
+    EXPECT_NEAR(model.getRMSE(), 0.0, 1e-9);
+    model.forecast(3);
+    EXPECT_NEAR(model.getForecasts()[2], 5.0 + 2.0 * 102, 1e-9);
+    EXPECT_TRUE(model.getSeasonals().empty());
+    EXPECT_EQ(model.getResidualACF(5).size(), 6);
+}
+
+TEST_F(HoltWintersTest, ThreadCountIndependent) {
+    HoltWintersFit single = fitHoltWinters(values.data(), values.size(), 7, 1);
+    HoltWintersFit parallel = fitHoltWinters(values.data(), values.size(), 7, 4);
+    EXPECT_EQ(single.alpha, parallel.alpha);
+    EXPECT_EQ(single.beta, parallel.beta);
+    EXPECT_EQ(single.gamma, parallel.gamma);
+    EXPECT_EQ(single.seasonals, parallel.seasonals);
+}
+
+TEST_F(HoltWintersTest, SimulatedPaths) {
+    HoltWinters model(data);
+    model.train(7);
+    model.forecast(14);
+    ForecastResult intervals = model.forecastIntervals(14, 0.9);
+
+    // Paths through the state recursion agree with the analytic forecasts
+    SimulationConfig config;
+    config.paths = 4000;
+    config.seed = 3;
+    SimulationResult paths = model.simulate(14, config);
+    ASSERT_EQ(paths.paths.cols(), 4000);
+    for (int h = 0; h < 14; ++h) {
+        EXPECT_NEAR(paths.mean[h], model.getForecasts()[h], 4.0 * intervals.stdErr[h] / std::sqrt(4000.0)) << "step " << h + 1;
+        double width = paths.bands(h, 2) - paths.bands(h, 0);
+        EXPECT_NEAR(width, intervals.upper[h] - intervals.lower[h], 0.1 * width) << "step " << h + 1;
+    }
+
+    config.innovations = InnovationType::BOOTSTRAP;
+    config.keepPaths = false;
+    SimulationResult bootstrap = model.simulate(14, config);
+    EXPECT_EQ(bootstrap.paths.size(), 0);
+    EXPECT_NEAR(bootstrap.mean.back(), model.getForecasts().back(), 0.5);
+}
+
+TEST_F(HoltWintersTest, InvalidArguments) {
+    HoltWinters model(data);
+    EXPECT_THROW(model.forecast(1), std::runtime_error);
+    EXPECT_THROW(model.simulate(5), std::runtime_error);
+    EXPECT_THROW(model.train(1), std::invalid_argument);
+    EXPECT_THROW(model.train(-2), std::invalid_argument);
+    EXPECT_THROW(model.train(350), std::invalid_argument);
+    model.train(7);
+    EXPECT_THROW(model.forecastIntervals(5, 1.5), std::invalid_argument);
+    EXPECT_THROW(model.simulate(0), std::invalid_argument);
+    EXPECT_THROW(model.save("holt_winters.bin"), std::runtime_error);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "timeseries/fitting.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+// Count every heap allocation made by the test binary
+std::atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+class LikelihoodTest : public testing::Test {
+protected:
+    LikelihoodTest() {
+        std::mt19937 rng(3);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        double x1 = 20.0;
+        for (int i = 0; i < 500; ++i) {
+            double x = 5.0 + 0.75 * x1 + noise(rng);
+            data.push_back(x);
+            x1 = x;
+        }
+    }
+
+    std::vector<double> data;
+};
+
+TEST_F(LikelihoodTest, NoAllocationsPerEvaluation) {
+    FitWorkspace workspace;
+    SeriesView ar = {data.data(), data.size(), 3, 0};
+    SeriesView ma = {data.data(), data.size(), 0, 3};
+    SeriesView arma = {data.data(), data.size(), 3, 2};
+    std::vector<double> params = {5.0, 0.5, 0.1, 0.05, 0.2, 0.1};
+
+    workspace.reserve(data.size(), 3, 3);
+    size_t before = allocationCount;
+    for (int i = 0; i < 100; ++i) {
+        getNLLAR(params.data(), ar, workspace);
+        getNLLMA(params.data(), ma, workspace);
+        getNLLARMA(params.data(), arma, workspace);
+    }
+    EXPECT_EQ(allocationCount - before, 0);
+}
+
+TEST_F(LikelihoodTest, MatchesReferenceARMA) {
+    // Straightforward ARMA(2, 1) residual recursion
+    std::vector<double> params = {4.0, 0.6, 0.1, 0.3};
+    std::vector<double> residuals(data.size(), 0.0);
+    double sumSq = 0.0;
+    for (size_t t = 2; t < data.size(); ++t) {
+        double prediction = params[0] + params[1] * data[t - 1] + params[2] * data[t - 2] + params[3] * residuals[t - 1];
+        residuals[t] = data[t] - prediction;
+        sumSq += residuals[t] * residuals[t];
+    }
+    double n = data.size() - 2;
+    double sigmaSq = sumSq / n;
+    double expected = 0.5 * n * std::log(2 * M_PI * sigmaSq) + (0.5 / sigmaSq) * sumSq;
+
+    FitWorkspace workspace;
+    workspace.reserve(data.size(), 2, 1);
+    SeriesView series = {data.data(), data.size(), 2, 1};
+    EXPECT_NEAR(getNLLARMA(params.data(), series, workspace), expected, 1e-8);
+    EXPECT_NEAR(workspace.residuals.back(), residuals.back(), 1e-10);
+}
+
+TEST_F(LikelihoodTest, ARMAReducesToAR) {
+    // ARMA(p, 0) and AR(p) share the same likelihood
+    std::vector<double> params = {4.0, 0.6, 0.1};
+    FitWorkspace workspace;
+    workspace.reserve(data.size(), 2, 0);
+    double ar = getNLLAR(params.data(), {data.data(), data.size(), 2, 0}, workspace);
+    double arma = getNLLARMA(params.data(), {data.data(), data.size(), 2, 0}, workspace);
+    EXPECT_NEAR(ar, arma, 1e-9);
+}
@@ -1,5 +1,14 @@
 #include "gtest/gtest.h"
 #include "priceseries.hpp"
+#include "data_provider.hpp"
+#include "overlays/bollinger.hpp"
+#include "overlays/macd.hpp"
+#include "overlays/sma.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <filesystem>
+#include <fstream>
 
 // Is there a better way to collect expected values?
 std::string expectedTicker = "AAPL";
@@ -160,4 +169,187 @@ TEST_F(PriceSeriesTest, Outputs) {
     EXPECT_NO_THROW(
         priceSeries->exportCSV();
     );
-}
\ No newline at end of file
+}
+
+TEST(PriceSeriesOverlayTest, AlignedToBars) {
+    SyntheticProvider provider(100.0, 0.0, 0.02, 3);
+    auto series = PriceSeries::getPriceSeries(provider, "AAA", dateStringToEpoch("2020-01-01"), dateStringToEpoch("2020-03-01"));
+    const auto dates = series->getDates();
+    const auto closes = series->getCloses();
+
+    // Values start after the warm-up bars and run to the last bar
+    auto sma = series->getSMA(5);
+    EXPECT_EQ(sma->getStartIndex(), 4);
+    ASSERT_EQ(sma->getLength(), dates.size() - 4);
+    EXPECT_NEAR(sma->getColumn(0)[0], (closes[0] + closes[1] + closes[2] + closes[3] + closes[4]) / 5, 1e-9);
+    EXPECT_EQ(sma->getDataMap().begin()->first, dates[4]);
+
+    auto macd = series->getMACD(3, 6, 4);
+    EXPECT_EQ(macd->getStartIndex(), 9);
+    EXPECT_EQ(macd->getLength(), dates.size() - 9);
+    EXPECT_EQ(macd->getDataMap().rbegin()->first, dates.back());
+    EXPECT_THROW(series->getMACD(30, 31, 30), std::invalid_argument);
+
+    // Midline is the moving average of the same bar
+    auto bands = series->getBollingerBands(5, 2);
+    ASSERT_EQ(bands->getWidth(), 3);
+    ASSERT_EQ(bands->getLength(), sma->getLength());
+    EXPECT_EQ(bands->getColumnName(1), "Middle Band");
+    EXPECT_EQ(bands->getColumn(1), sma->getValues());
+    for (size_t i = 0; i < bands->getLength(); ++i) {
+        EXPECT_LT(bands->getColumn(0)[i], bands->getColumn(2)[i]);
+    }
+
+    // Printed tables leave warm-up bars blank
+    series->addMACD(3, 6, 4);
+    EXPECT_NE(series->getHead(3, true).find(fmt::format("│\033[37m{:>12}\033[0m│", "")), std::string::npos);
+    EXPECT_EQ(series->getTail(3, true).find(fmt::format("│\033[37m{:>12}\033[0m│", "")), std::string::npos);
+
+    // Exported rows are blank during the warm-up
+    series->addSMA(5);
+    std::string path = (std::filesystem::temp_directory_path() / "aligned_overlays.csv").string();
+    series->exportCSV(path);
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    std::filesystem::remove(path);
+    ASSERT_EQ(lines.size(), dates.size());
+    EXPECT_EQ(lines[3].back(), ',');
+    std::string expected = fmt::format(",{:.2f}", sma->getValues()[0]);
+    EXPECT_EQ(lines[4].substr(lines[4].size() - expected.size()), expected);
+}
+
+TEST(PriceSeriesResampleTest, AggregatesBars) {
+    SyntheticProvider provider(100.0, 0.0, 0.01, 5);
+    auto hourly = PriceSeries::getPriceSeries(provider, "AAA", dateStringToEpoch("2020-01-01"), dateStringToEpoch("2020-03-01"), "1h");
+    const auto opens = hourly->getOpens();
+    const auto highs = hourly->getHighs();
+    const auto lows = hourly->getLows();
+    const auto closes = hourly->getCloses();
+    const auto volumes = hourly->getVolumes();
+
+    auto daily = hourly->resample(DAY_INTERVAL);
+    ASSERT_EQ(daily->getCount(), 60);
+    EXPECT_EQ(daily->getInterval(), "1d");
+    EXPECT_EQ(daily->getTicker(), "AAA");
+    EXPECT_EQ(daily->getDates()[1], dateStringToEpoch("2020-01-02"));
+    EXPECT_EQ(daily->getOpens()[1], opens[24]);
+    EXPECT_EQ(daily->getHighs()[1], *std::max_element(highs.begin() + 24, highs.begin() + 48));
+    EXPECT_EQ(daily->getLows()[1], *std::min_element(lows.begin() + 24, lows.begin() + 48));
+    EXPECT_EQ(daily->getCloses()[1], closes[47]);
+    EXPECT_EQ(daily->getVolumes()[1], std::accumulate(volumes.begin() + 24, volumes.begin() + 48, 0L));
+
+    // Calendar buckets, the first week starting on the Monday before
+    auto weekly = daily->resample(WEEK_INTERVAL);
+    EXPECT_EQ(weekly->getDates().front(), dateStringToEpoch("2019-12-30"));
+    EXPECT_EQ(weekly->getCount(), 9);
+    auto monthly = hourly->resample(MONTH_INTERVAL);
+    ASSERT_EQ(monthly->getCount(), 2);
+    EXPECT_EQ(monthly->getDates()[1], dateStringToEpoch("2020-02-01"));
+    EXPECT_EQ(monthly->getCloses()[1], closes.back());
+    EXPECT_EQ(monthly->getHighs()[0], *std::max_element(highs.begin(), highs.begin() + 31 * 24));
+
+    EXPECT_THROW(daily->resample(HOUR_INTERVAL), std::invalid_argument);
+    EXPECT_THROW(hourly->resample(Interval::fromString("90m")), std::invalid_argument);
+    EXPECT_EQ(hourly->resample(Interval::fromString("3h"))->getCount(), 60 * 8);
+}
+
+// Stands in for yfinance.download with a deterministic multi-ticker frame,
+// BBB only has data from its fourth day
+const char* standInProvider = R"(
+import sys, types
+import numpy as np
+import pandas as pd
+
+def download(tickers, start=None, end=None, **kwargs):
+    dates = pd.date_range(start, end, freq='D')[:-1]
+    frames = {}
+    for k, ticker in enumerate(tickers):
+        base = 100.0 * (k + 1) + np.arange(len(dates))
+        frames[ticker] = pd.DataFrame({
+            'Open': base, 'High': base + 1, 'Low': base - 1, 'Close': base + 0.5,
+            'Adj Close': base + 0.25, 'Volume': 1000 * (k + 1) + np.arange(len(dates))
+        }, index=pd.DatetimeIndex(dates, name='Date'))
+    frames['BBB'].iloc[:3] = np.nan
+    return pd.concat(frames, axis=1)
+
+stand_in = types.ModuleType('yfinance')
+stand_in.download = download
+saved_yfinance = sys.modules.get('yfinance')
+sys.modules['yfinance'] = stand_in
+)";
+
+class PriceSeriesBatchTest : public testing::Test {
+protected:
+    PriceSeriesBatchTest() {
+        matplotlibcpp::detail::_interpreter::get();
+        PyRun_SimpleString(standInProvider);
+    }
+
+    ~PriceSeriesBatchTest() {
+        PyRun_SimpleString(
+            "if saved_yfinance is None:\n"
+            "    del sys.modules['yfinance']\n"
+            "else:\n"
+            "    sys.modules['yfinance'] = saved_yfinance\n");
+    }
+
+    std::vector<std::string> tickers = {"AAA", "BBB", "CCC"};
+};
+
+TEST_F(PriceSeriesBatchTest, SplitsTickers) {
+    auto batch = PriceSeries::getPriceSeriesBatch(tickers, "2020-01-01", "2020-01-11");
+    ASSERT_EQ(batch.size(), 3);
+
+    // Rows are dropped as for getPriceSeries, and BBB's missing days are skipped
+    std::vector<int> expectedCounts = {9, 6, 9};
+    std::vector<std::string> expectedFirstDates = {"2020-01-02", "2020-01-05", "2020-01-02"};
+    for (std::size_t k = 0; k < batch.size(); ++k) {
+        const auto& series = *batch[k];
+        EXPECT_EQ(series.getTicker(), tickers[k]);
+        ASSERT_EQ(series.getCount(), expectedCounts[k]);
+        EXPECT_EQ(series.getDates().front(), dateStringToEpoch(expectedFirstDates[k]));
+
+        double firstOpen = 100.0 * (k + 1) + (10 - expectedCounts[k]);
+        EXPECT_DOUBLE_EQ(series.getOpens().front(), firstOpen);
+        EXPECT_DOUBLE_EQ(series.getHighs().front(), firstOpen + 1);
+        EXPECT_DOUBLE_EQ(series.getLows().front(), firstOpen - 1);
+        EXPECT_DOUBLE_EQ(series.getCloses().back(), 100.0 * (k + 1) + 9.5);
+        EXPECT_DOUBLE_EQ(series.getAdjCloses().back(), 100.0 * (k + 1) + 9.25);
+        EXPECT_EQ(series.getVolumes().back(), static_cast<long>(1000 * (k + 1) + 9));
+    }
+}
+
+TEST_F(PriceSeriesBatchTest, PreparesAsTickersLand) {
+    std::atomic<int> prepared{0};
+    auto batch = PriceSeries::getPriceSeriesBatch(tickers, "2020-01-01", "2020-01-11", "1d",
+        [&](PriceSeries& series) {
+            EXPECT_GT(series.getCount(), 0);
+            series.addSMA(3);
+            ++prepared;
+        }, 2);
+
+    EXPECT_EQ(prepared, 3);
+    for (const auto& series : batch) {
+        EXPECT_EQ(series->getOverlays().size(), 1);
+    }
+
+    EXPECT_THROW(
+        PriceSeries::getPriceSeriesBatch(tickers, "2020-01-01", "2020-01-11", "1d",
+            [](PriceSeries&) { throw std::runtime_error("failed"); }),
+        std::runtime_error
+    );
+}
+
+TEST_F(PriceSeriesBatchTest, InvalidArguments) {
+    EXPECT_THROW(
+        PriceSeries::getPriceSeriesBatch({}, "2020-01-01", "2020-01-11"),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        PriceSeries::getPriceSeriesBatch(tickers, "2020-01-01", "2020-01-11", "xyz"),
+        std::invalid_argument
+    );
+}
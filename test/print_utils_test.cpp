@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "print_utils.hpp"
+
+#include <cmath>
+#include <sstream>
+
+class PrintUtilsTest : public testing::Test {
+protected:
+    PrintUtilsTest() {
+        for (int i = 0; i < 50; ++i) {
+            prices.push_back(100.0 + 5.0 * std::sin(0.7 * i));
+            volumes.push_back(1000 + 37 * (i % 5));
+        }
+    }
+
+    NumericTable getNumericTable() const {
+        NumericTable table("Prices", prices.size());
+        table.setLabels("Row", 8, [](std::size_t i) { return fmt::format("r{}", i); });
+        table.addColumn("Price", 10, prices.data());
+        table.addColumn("Volume", 12, volumes.data());
+        return table;
+    }
+
+    std::vector<double> prices;
+    std::vector<long> volumes;
+};
+
+TEST_F(PrintUtilsTest, MatchesStringTable) {
+    // Numeric rendering agrees byte for byte with the string table, with and
+    // without highlighting
+    std::vector<std::vector<std::string>> tableData;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        tableData.push_back({fmt::format("r{}", i), fmt::format("{:.3f}", prices[i]), fmt::format("{}", volumes[i])});
+    }
+    NumericTable table = getNumericTable();
+    for (bool highlighting : {false, true}) {
+        EXPECT_EQ(table.toString(highlighting), getTable("Prices", tableData, {8, 10, 12}, {"Row", "Price", "Volume"}, highlighting));
+    }
+
+    std::ostringstream stream;
+    table.write(stream, true);
+    EXPECT_EQ(stream.str(), table.toString(true));
+}
+
+TEST_F(PrintUtilsTest, Paging) {
+    NumericTable table = getNumericTable();
+    std::string full = table.toString(true);
+
+    // A page colors its first row against the row before it, so its rows
+    // match the full table
+    std::string page = table.getPage(20, 5, true);
+    size_t rowStart = page.find("│\033[37mr20");
+    ASSERT_NE(rowStart, std::string::npos);
+    std::string rows = page.substr(rowStart, page.find("└") - rowStart);
+    EXPECT_NE(full.find(rows), std::string::npos);
+    EXPECT_EQ(page.find("r19"), std::string::npos);
+    EXPECT_EQ(page.find("r25"), std::string::npos);
+
+    // Pages past the end are clipped
+    EXPECT_NE(table.getPage(48, 10).find("r49"), std::string::npos);
+    EXPECT_EQ(table.getPage(60, 10), table.getPage(50, 0));
+
+    std::string headTail = table.getHeadTail(3, 2);
+    EXPECT_NE(headTail.find("r2 "), std::string::npos);
+    EXPECT_EQ(headTail.find("r3 "), std::string::npos);
+    EXPECT_NE(headTail.find("..."), std::string::npos);
+    EXPECT_NE(headTail.find("r48"), std::string::npos);
+    EXPECT_EQ(table.getHeadTail(30, 30), table.toString());
+}
+
+TEST_F(PrintUtilsTest, MissingValues) {
+    std::vector<double> values = {NAN, 1.0, NAN, 2.0, 0.5};
+    NumericTable table("Sparse", values.size());
+    table.addColumn("Value", 8, values.data(), 2);
+    std::string text = table.toString(true);
+
+    // Blanks print white, the first number has nothing to compare against
+    EXPECT_NE(text.find(fmt::format("│\033[37m{:>8}\033[0m│", "")), std::string::npos);
+    EXPECT_NE(text.find("\033[37m    1.00"), std::string::npos);
+    EXPECT_NE(text.find("\033[32m    2.00"), std::string::npos);
+    EXPECT_NE(text.find("\033[31m    0.50"), std::string::npos);
+}
+
+TEST_F(PrintUtilsTest, OffsetColumn) {
+    // Values cover rows 2 and 3 only
+    std::vector<double> values = {1.0, 2.0};
+    NumericTable table("Offset", 5);
+    table.addColumn("Value", 8, values.data(), 2, values.size(), 2);
+    std::string text = table.toString();
+
+    std::string blank = fmt::format("│\033[37m{:>8}\033[0m│", "");
+    std::size_t count = 0;
+    for (std::size_t at = text.find(blank); at != std::string::npos; at = text.find(blank, at + 1)) {
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+    EXPECT_LT(text.find("    1.00"), text.find("    2.00"));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "python_worker.hpp"
+
+#include <cmath>
+#include <filesystem>
+
+class PythonWorkerTest : public testing::Test {
+protected:
+    PythonWorkerTest() {
+        std::vector<std::time_t> dates;
+        std::vector<double> closes;
+        for (int i = 0; i < 500; ++i) {
+            dates.push_back(1577836800 + 86400 * i);
+            closes.push_back(100.0 + 10.0 * std::sin(0.05 * i));
+        }
+        auto priceSeries = std::make_shared<PriceSeries>();
+        priceSeries->setDates(dates);
+        priceSeries->setCloses(closes);
+        priceSeries->setCount(dates.size());
+        series = priceSeries;
+
+        directory = std::filesystem::temp_directory_path() / "python_worker_test";
+        std::filesystem::create_directories(directory);
+    }
+
+    ~PythonWorkerTest() {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string getPath(const std::string& name) const {
+        return (directory / name).string();
+    }
+
+    std::shared_ptr<const PriceSeries> series;
+    std::filesystem::path directory;
+};
+
+TEST_F(PythonWorkerTest, Submit) {
+    PythonWorker worker;
+    auto value = worker.submit([] {
+        PyObject* result = PyRun_String("6 * 7", Py_eval_input, PyEval_GetBuiltins(), nullptr);
+        long value = PyLong_AsLong(result);
+        Py_DECREF(result);
+        return value;
+    });
+    auto failure = worker.submit([] {
+        throw std::runtime_error("failed");
+    });
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_THROW(failure.get(), std::runtime_error);
+}
+
+TEST_F(PythonWorkerTest, PlotFromManyThreads) {
+    PythonWorker worker;
+    std::vector<std::future<void>> charts(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < charts.size(); ++i) {
+        threads.emplace_back([&, i] {
+            charts[i] = worker.plotAsync(series, getPath(fmt::format("chart{}.png", i)), i % 2 ? "area" : "line");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t i = 0; i < charts.size(); ++i) {
+        charts[i].get();
+        EXPECT_TRUE(std::filesystem::exists(getPath(fmt::format("chart{}.png", i))));
+    }
+
+    // A failed save is reported through the future and later charts still work
+    EXPECT_THROW(worker.plotAsync(series, getPath("missing/chart.png")).get(), std::runtime_error);
+    worker.plotAsync(series, getPath("chart.png")).get();
+    EXPECT_TRUE(std::filesystem::exists(getPath("chart.png")));
+}
+
+TEST_F(PythonWorkerTest, FetchAsync) {
+    PythonWorker worker;
+    auto aapl = worker.fetchAsync("AAPL", "2020-01-01", "2020-01-31");
+    auto msft = worker.fetchAsync("MSFT", "2020-01-01", "2020-01-31");
+    EXPECT_GT(aapl.get()->getCount(), 0);
+    EXPECT_GT(msft.get()->getCount(), 0);
+
+    auto invalid = worker.fetchAsync("AAPL", "2020-01-01", "2020-01-31", "xyz");
+    EXPECT_THROW(invalid.get(), std::invalid_argument);
+}
+
+TEST_F(PythonWorkerTest, InvalidPlots) {
+    PythonWorker worker;
+    EXPECT_THROW(worker.plotAsync(series, ""), std::invalid_argument);
+    EXPECT_THROW(worker.plotAsync(nullptr, getPath("chart.png")), std::invalid_argument);
+    EXPECT_THROW(worker.plotAsync(series, getPath("chart.png"), "pie"), std::invalid_argument);
+}
+
+TEST_F(PythonWorkerTest, SharesInterpreterWithRenderQueue) {
+    // Destroying the worker first keeps the interpreter released for the
+    // queue, and the queue gives it back to this thread. They draw in turn
+    // as pyplot's current figure is shared.
+    {
+        auto worker = std::make_unique<PythonWorker>();
+        RenderQueue queue;
+        worker->plotAsync(series, getPath("worker.png")).get();
+        worker.reset();
+
+        PlotSpec spec;
+        spec.dpi = 50;
+        for (int i = 0; i < 4; ++i) {
+            queue.submit(series, spec, getPath(fmt::format("queue{}.png", i)));
+        }
+        EXPECT_EQ(queue.wait().rendered, 4);
+        EXPECT_FALSE(PyGILState_Check());
+    }
+    EXPECT_TRUE(PyGILState_Check());
+}
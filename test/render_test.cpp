@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "render.hpp"
+
+#include <cmath>
+#include <filesystem>
+
+class RenderTest : public testing::Test {
+protected:
+    RenderTest() {
+        std::vector<std::time_t> dates;
+        std::vector<double> closes;
+        for (int i = 0; i < 3000; ++i) {
+            dates.push_back(1577836800 + 86400 * i);
+            closes.push_back(100.0 + 10.0 * std::sin(0.01 * i));
+        }
+        auto priceSeries = std::make_shared<PriceSeries>();
+        priceSeries->setDates(dates);
+        priceSeries->setCloses(closes);
+        priceSeries->setCount(dates.size());
+        series = priceSeries;
+
+        directory = std::filesystem::temp_directory_path() / "render_test";
+        std::filesystem::create_directories(directory);
+    }
+
+    ~RenderTest() {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string getPath(const std::string& name) const {
+        return (directory / name).string();
+    }
+
+    std::shared_ptr<const PriceSeries> series;
+    std::filesystem::path directory;
+};
+
+TEST_F(RenderTest, RendersBatch) {
+    PlotSpec line;
+    line.dpi = 50;
+    PlotSpec area = line;
+    area.type = "area";
+    PlotSpec small = line;
+    small.width = 600;
+    small.height = 400;
+
+    RenderQueue queue;
+    std::vector<RenderJob> jobs;
+    for (int i = 0; i < 6; ++i) {
+        const PlotSpec& spec = i % 3 == 0 ? line : (i % 3 == 1 ? area : small);
+        jobs.push_back({series, spec, getPath(fmt::format("chart{}.png", i))});
+    }
+    queue.submit(jobs);
+    RenderStats stats = queue.wait();
+
+    EXPECT_EQ(stats.rendered, 6);
+    EXPECT_EQ(stats.failed, 0);
+    EXPECT_GT(stats.getChartsPerSecond(), 0.0);
+    for (int i = 0; i < 6; ++i) {
+        std::string path = getPath(fmt::format("chart{}.png", i));
+        ASSERT_TRUE(std::filesystem::exists(path));
+        EXPECT_GT(std::filesystem::file_size(path), 0);
+    }
+    EXPECT_NE(stats.toString().find("Charts/sec"), std::string::npos);
+}
+
+TEST_F(RenderTest, ReportsFailures) {
+    // A failed save is recorded and later jobs still render
+    PlotSpec spec;
+    spec.dpi = 50;
+    RenderQueue queue;
+    queue.submit(series, spec, getPath("missing/chart.png"));
+    queue.submit(series, spec, getPath("chart.png"));
+    RenderStats stats = queue.wait();
+
+    EXPECT_EQ(stats.rendered, 1);
+    EXPECT_EQ(stats.failed, 1);
+    ASSERT_EQ(stats.errors.size(), 1);
+    EXPECT_EQ(stats.errors[0].find(getPath("missing/chart.png")), 0);
+    EXPECT_TRUE(std::filesystem::exists(getPath("chart.png")));
+}
+
+TEST_F(RenderTest, InvalidJobs) {
+    RenderQueue queue;
+    PlotSpec spec;
+    EXPECT_THROW(queue.submit(nullptr, spec, getPath("chart.png")), std::invalid_argument);
+    EXPECT_THROW(queue.submit(std::make_shared<PriceSeries>(), spec, getPath("chart.png")), std::invalid_argument);
+    EXPECT_THROW(queue.submit(series, spec, ""), std::invalid_argument);
+    spec.type = "pie";
+    EXPECT_THROW(queue.submit(series, spec, getPath("chart.png")), std::invalid_argument);
+    spec.type = "line";
+    spec.dpi = 0;
+    EXPECT_THROW(queue.submit(series, spec, getPath("chart.png")), std::invalid_argument);
+    EXPECT_EQ(queue.wait().rendered, 0);
+}
+
+TEST_F(RenderTest, OverlappingQueues) {
+    // The first queue destroyed leaves the interpreter released for the
+    // second, the last one gives the GIL back to this thread
+    PlotSpec spec;
+    spec.dpi = 50;
+    auto first = std::make_unique<RenderQueue>();
+    RenderQueue second;
+    first->submit(series, spec, getPath("first.png"));
+    EXPECT_EQ(first->wait().rendered, 1);
+    first.reset();
+    for (int i = 0; i < 4; ++i) {
+        second.submit(series, spec, getPath(fmt::format("second{}.png", i)));
+    }
+    EXPECT_EQ(second.wait().rendered, 4);
+    EXPECT_FALSE(PyGILState_Check());
+}
+
+TEST_F(RenderTest, GivesBackInterpreter) {
+    {
+        RenderQueue queue;
+        EXPECT_FALSE(PyGILState_Check());
+    }
+    EXPECT_TRUE(PyGILState_Check());
+}
+
+TEST_F(RenderTest, DestroyedOnOtherThread) {
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_DEATH({
+        auto queue = std::make_unique<RenderQueue>();
+        std::thread([&] { queue.reset(); }).join();
+    }, "Could not give back the interpreter");
+}
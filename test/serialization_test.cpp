@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+class SerializationTest : public testing::Test {
+protected:
+    SerializationTest() {
+        std::mt19937 rng(12);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        double last = 0.0;
+        double shock = 0.0;
+        for (int i = 0; i < 300; ++i) {
+            double next = noise(rng);
+            last = 1.0 + 0.5 * last + next + 0.3 * shock;
+            shock = next;
+            data[86400 * i] = last;
+        }
+    }
+
+    ~SerializationTest() override {
+        std::remove(path.c_str());
+    }
+
+    TimeSeries<double> data;
+    std::string path = "serialization_test_models.bin";
+};
+
+TEST_F(SerializationTest, RoundTrip) {
+    auto ar = std::make_shared<AR>(data);
+    auto ma = std::make_shared<MA>(data);
+    auto arma = std::make_shared<ARMA>(data);
+    ar->train(2);
+    ma->train(1);
+    arma->train(2, 1);
+    std::vector<std::shared_ptr<TimeSeriesModel>> models = {ar, ma, arma};
+    saveModels(path, models);
+
+    ModelStore store(path);
+    ASSERT_EQ(store.size(), 3);
+    EXPECT_EQ(store.getRecord(0).type, ModelType::AR);
+    EXPECT_EQ(store.getRecord(1).type, ModelType::MA);
+    EXPECT_EQ(store.getRecord(2).type, ModelType::ARMA);
+    EXPECT_THROW(store.getRecord(3), std::invalid_argument);
+
+    // Loaded models forecast exactly like the trained ones
+    auto loaded = store.getModels();
+    for (size_t i = 0; i < models.size(); ++i) {
+        ModelFit expected = models[i]->getFit();
+        ModelFit actual = loaded[i]->getFit();
+        EXPECT_EQ(actual.c, expected.c);
+        EXPECT_EQ(actual.phis, expected.phis);
+        EXPECT_EQ(actual.thetas, expected.thetas);
+        EXPECT_EQ(actual.rmse, expected.rmse);
+        EXPECT_EQ(loaded[i]->toString(), models[i]->toString());
+
+        models[i]->forecast(30);
+        loaded[i]->forecast(30);
+        EXPECT_EQ(loaded[i]->getForecasts(), models[i]->getForecasts());
+        EXPECT_EQ(loaded[i]->getForecasted(), models[i]->getForecasted());
+        EXPECT_EQ(loaded[i]->forecastIntervals(30).stdErr, models[i]->forecastIntervals(30).stdErr);
+    }
+
+    // Saved models have no history to simulate from
+    EXPECT_THROW(loaded[0]->simulate(10), std::runtime_error);
+}
+
+TEST_F(SerializationTest, SingleModel) {
+    ARMA arma(data);
+    EXPECT_THROW(arma.save(path), std::runtime_error);
+    arma.train(1, 1);
+    arma.save(path);
+
+    auto loaded = TimeSeriesModel::load(path);
+    ASSERT_NE(std::dynamic_pointer_cast<ARMA>(loaded), nullptr);
+    arma.forecast(10);
+    loaded->forecast(10);
+    EXPECT_EQ(loaded->getForecasts(), arma.getForecasts());
+
+    GARCH garch(data);
+    garch.train();
+    EXPECT_THROW(garch.save(path), std::runtime_error);
+}
+
+TEST_F(SerializationTest, RestoredModelsDoNotPlot) {
+    ModelRecord record;
+    record.type = ModelType::AR;
+    record.fit.c = 1.0;
+    record.fit.phis = {0.5};
+    record.values = {2.0};
+    record.lastDate = 86400;
+
+    auto restored = makeModel(record);
+    EXPECT_THROW(restored->plot(), std::runtime_error);
+}
+
+TEST_F(SerializationTest, BulkStream) {
+    // Many records through streams and the memory map
+    std::vector<ModelRecord> records(2000);
+    for (size_t i = 0; i < records.size(); ++i) {
+        ModelRecord& record = records[i];
+        record.type = ModelType::ARMA;
+        record.fit.c = i;
+        record.fit.phis.assign(i % 4, 0.1 * i);
+        record.fit.thetas.assign(i % 3, -0.1 * i);
+        record.values.assign(i % 4, 1.0 * i);
+        record.residuals.assign(i % 3, 2.0 * i);
+        record.lastDate = 86400 * i;
+    }
+
+    std::stringstream stream;
+    writeModels(stream, records);
+    std::vector<ModelRecord> read = readModels(stream);
+    ASSERT_EQ(read.size(), records.size());
+    EXPECT_EQ(read[1234].fit.phis, records[1234].fit.phis);
+    EXPECT_EQ(read[1234].residuals, records[1234].residuals);
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << stream.str();
+    }
+    ModelStore store(path);
+    ASSERT_EQ(store.size(), records.size());
+    for (size_t i : {0, 1, 999, 1999}) {
+        ModelRecord record = store.getRecord(i);
+        EXPECT_EQ(record.fit.c, records[i].fit.c);
+        EXPECT_EQ(record.fit.thetas, records[i].fit.thetas);
+        EXPECT_EQ(record.values, records[i].values);
+        EXPECT_EQ(record.lastDate, records[i].lastDate);
+    }
+}
+
+TEST_F(SerializationTest, InvalidFiles) {
+    EXPECT_THROW(ModelStore("does_not_exist.bin"), std::runtime_error);
+
+    ModelRecord record;
+    record.fit.phis = {0.5};
+    record.values = {1.0};
+    std::stringstream stream;
+    writeModels(stream, {record});
+    std::string bytes = stream.str();
+
+    auto expectInvalid = [&](const std::string& contents) {
+        std::ofstream(path, std::ios::binary) << contents;
+        EXPECT_THROW(ModelStore store(path), std::runtime_error);
+    };
+    expectInvalid("CPF");
+    expectInvalid("XXXX" + bytes.substr(4));
+    expectInvalid(bytes.substr(0, bytes.size() - 1));
+    std::string version = bytes;
+    version[4] = 9;
+    expectInvalid(version);
+
+    // Lag state must match the orders
+    record.values.clear();
+    EXPECT_THROW(writeModels(stream, {record}), std::invalid_argument);
+}
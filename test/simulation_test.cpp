@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "timeseries/timeseries_models.hpp"
+
+#include <random>
+
+class SimulationTest : public testing::Test {
+protected:
+    SimulationTest() {
+        // AR(1) fit with unit noise and its residuals on a matching series
+        fit.c = 1.0;
+        fit.phis = {0.8};
+        fit.mse = fit.rmse = fit.mae = 1.0;
+
+        std::mt19937 rng(9);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        double x1 = 5.0;
+        for (int i = 0; i < 400; ++i) {
+            double shock = noise(rng);
+            double x = fit.c + fit.phis[0] * x1 + shock;
+            data.push_back(x);
+            residuals.push_back(i == 0 ? 0.0 : shock);
+            x1 = x;
+        }
+    }
+
+    ModelFit fit;
+    std::vector<double> data;
+    std::vector<double> residuals;
+};
+
+TEST_F(SimulationTest, MeanAndBands) {
+    SimulationConfig config;
+    config.paths = 20000;
+    config.quantiles = {0.025, 0.5, 0.975};
+    auto result = simulatePaths(fit, data.data(), residuals.data(), data.size(), 10, config);
+
+    ASSERT_EQ(result.paths.rows(), 10);
+    ASSERT_EQ(result.paths.cols(), 20000);
+    ASSERT_EQ(result.bands.cols(), 3);
+
+    // Conditional mean and variance of an AR(1)
+    double mean = data.back();
+    double variance = 0.0;
+    for (int h = 0; h < 10; ++h) {
+        mean = fit.c + fit.phis[0] * mean;
+        variance = variance * fit.phis[0] * fit.phis[0] + 1.0;
+        double sd = std::sqrt(variance);
+        EXPECT_NEAR(result.mean[h], mean, 0.05);
+        EXPECT_NEAR(result.bands(h, 1), mean, 0.06);
+        EXPECT_NEAR(result.bands(h, 2) - result.bands(h, 0), 2 * 1.96 * sd, 0.15 * sd);
+    }
+}
+
+TEST_F(SimulationTest, Deterministic) {
+    SimulationConfig config;
+    config.paths = 1500;
+    config.seed = 17;
+    config.threadCount = 1;
+    auto sequential = simulatePaths(fit, data.data(), residuals.data(), data.size(), 150, config);
+
+    // Same seed gives the same paths across thread counts
+    config.threadCount = 4;
+    auto parallel = simulatePaths(fit, data.data(), residuals.data(), data.size(), 150, config);
+    EXPECT_EQ(sequential.paths, parallel.paths);
+
+    // Bands without materialised paths match those from full paths
+    config.keepPaths = false;
+    auto bandsOnly = simulatePaths(fit, data.data(), residuals.data(), data.size(), 150, config);
+    EXPECT_EQ(bandsOnly.paths.size(), 0);
+    EXPECT_EQ(bandsOnly.mean, sequential.mean);
+    EXPECT_EQ(bandsOnly.bands, sequential.bands);
+}
+
+TEST_F(SimulationTest, BootstrapInnovations) {
+    SimulationConfig config;
+    config.paths = 5000;
+    config.innovations = InnovationType::BOOTSTRAP;
+    auto result = simulatePaths(fit, data.data(), residuals.data(), data.size(), 1, config);
+
+    // One step ahead values are the point forecast plus a training residual
+    double forecast = fit.c + fit.phis[0] * data.back();
+    double minResidual = *std::min_element(residuals.begin() + 1, residuals.end());
+    double maxResidual = *std::max_element(residuals.begin() + 1, residuals.end());
+    EXPECT_GE(result.paths.minCoeff(), forecast + minResidual - 1e-9);
+    EXPECT_LE(result.paths.maxCoeff(), forecast + maxResidual + 1e-9);
+}
+
+TEST_F(SimulationTest, InvalidArguments) {
+    SimulationConfig config;
+    EXPECT_THROW(simulatePaths(fit, data.data(), residuals.data(), data.size(), 0, config), std::invalid_argument);
+
+    config.quantiles = {1.5};
+    EXPECT_THROW(simulatePaths(fit, data.data(), residuals.data(), data.size(), 5, config), std::invalid_argument);
+
+    // Untrained model
+    TimeSeries<double> series;
+    for (size_t i = 0; i < data.size(); ++i) {
+        series[i] = data[i];
+    }
+    AR ar(series);
+    EXPECT_THROW(ar.simulate(5), std::runtime_error);
+    ar.train(1);
+    EXPECT_NO_THROW(ar.simulate(5));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "time_utils.hpp"
+
+#include <thread>
+
+static_assert(daysFromCivil(1970, 1, 1) == 0, "Epoch is day zero");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "Leap day is counted");
+static_assert(civilFromDays(-1).year == 1969 && civilFromDays(-1).day == 31, "Days before the epoch");
+
+// Local standard time midnight as the old mktime based parsing gave
+std::time_t getMidnight(int year, int month, int day) {
+    std::tm tm = {};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_isdst = 0;
+    return std::mktime(&tm);
+}
+
+TEST(TimeUtilsTest, CivilDays) {
+    for (std::int64_t days = -800000; days < 800000; days += 97) {
+        CivilDate date = civilFromDays(days);
+        EXPECT_EQ(daysFromCivil(date.year, date.month, date.day), days);
+    }
+    // Days past the end of a month carry over
+    EXPECT_EQ(daysFromCivil(2021, 2, 29), daysFromCivil(2021, 3, 1));
+}
+
+TEST(TimeUtilsTest, SingleDates) {
+    EXPECT_EQ(dateStringToEpoch("2020-01-01"), getMidnight(2020, 1, 1));
+    EXPECT_EQ(dateStringToEpoch("2020-07-15"), getMidnight(2020, 7, 15));
+    EXPECT_EQ(dateStringToEpoch("2020-7-5"), getMidnight(2020, 7, 5));
+    EXPECT_EQ(dateStringToEpoch("2020-07-15 12:00:00"), getMidnight(2020, 7, 15));
+    EXPECT_EQ(dateStringToEpoch("2020/07/15"), -1);
+    EXPECT_EQ(dateStringToEpoch("2020-13-01"), -1);
+
+    EXPECT_EQ(epochToDateString(getMidnight(2020, 7, 15)), "2020-07-15");
+    EXPECT_EQ(epochToDateString(getMidnight(2019, 12, 31) + 3723, true), "2019-12-31 01:02:03");
+}
+
+TEST(TimeUtilsTest, Columns) {
+    std::vector<std::time_t> dates;
+    for (int i = 0; i < 1000; ++i) {
+        dates.push_back(getMidnight(2019, 1, 1) + i * DAY_DURATION);
+    }
+
+    std::string text(dates.size() * DATE_LENGTH, ' ');
+    formatDates(dates.data(), dates.size(), text.data());
+    std::vector<std::string> strings;
+    for (std::size_t i = 0; i < dates.size(); ++i) {
+        strings.push_back(text.substr(i * DATE_LENGTH, DATE_LENGTH));
+        EXPECT_EQ(strings.back(), epochToDateString(dates[i]));
+    }
+    EXPECT_EQ(strings[365], "2020-01-01");
+
+    std::vector<std::time_t> parsed(strings.size());
+    EXPECT_EQ(parseDates(strings.data(), strings.size(), parsed.data()), 0);
+    EXPECT_EQ(parsed, dates);
+
+    strings[3] = "not a date";
+    EXPECT_EQ(parseDates(strings.data(), strings.size(), parsed.data()), 1);
+    EXPECT_EQ(parsed[3], -1);
+
+    // Wall clock seconds are the dates as if they were UTC
+    std::vector<std::time_t> wallClock = {daysFromCivil(2019, 1, 1) * DAY_DURATION, daysFromCivil(2019, 7, 1) * DAY_DURATION};
+    wallClockToEpoch(wallClock.data(), wallClock.size(), wallClock.data());
+    EXPECT_EQ(wallClock[0], getMidnight(2019, 1, 1));
+    EXPECT_EQ(wallClock[1], getMidnight(2019, 7, 1));
+}
+
+TEST(TimeUtilsTest, ManyThreads) {
+    std::vector<std::time_t> dates;
+    for (int i = 0; i < 5000; ++i) {
+        dates.push_back(getMidnight(2000, 1, 1) + i * 3 * HOUR_DURATION);
+    }
+    std::string expected(dates.size() * DATETIME_LENGTH, ' ');
+    formatDates(dates.data(), dates.size(), expected.data(), true);
+
+    std::vector<std::string> texts(8, std::string(expected.size(), ' '));
+    std::vector<std::thread> threads;
+    for (auto& text : texts) {
+        threads.emplace_back([&] { formatDates(dates.data(), dates.size(), text.data(), true); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& text : texts) {
+        EXPECT_EQ(text, expected);
+    }
+}
+
+static_assert(Interval::fromString("15m") == Interval(15, Interval::Unit::MINUTE), "Intervals parse at compile time");
+static_assert(DAY_INTERVAL.getSeconds() == DAY_DURATION, "Day intervals are one day long");
+
+TEST(TimeUtilsTest, Intervals) {
+    for (const auto& text : VALID_INTERVALS) {
+        Interval interval = Interval::fromString(text);
+        EXPECT_EQ(interval.toString(), text);
+        EXPECT_EQ(interval.getSeconds(), intervalToSeconds(std::string(text)));
+    }
+    EXPECT_EQ(Interval::fromString("4h").getSeconds(), 4 * HOUR_DURATION);
+    EXPECT_EQ(intervalToSeconds("4h"), -1);
+    EXPECT_THROW(Interval::fromString("0d"), std::invalid_argument);
+    EXPECT_THROW(Interval::fromString("1x"), std::invalid_argument);
+    EXPECT_THROW(Interval::fromString("d"), std::invalid_argument);
+    EXPECT_THROW(Interval(0, Interval::Unit::DAY), std::invalid_argument);
+
+    // Weekday bars with a weekend gap are still a day apart
+    std::vector<std::time_t> weekdays = {0, 1, 2, 3, 4, 7, 8};
+    for (auto& date : weekdays) {
+        date *= DAY_DURATION;
+    }
+    EXPECT_EQ(getMedianSpacing(weekdays.data(), weekdays.size()), DAY_DURATION);
+    EXPECT_EQ(getMedianSpacing(weekdays.data(), 1), DAY_DURATION);
+}
+
+TEST(TimeUtilsTest, Buckets) {
+    // Wednesday afternoon
+    std::time_t date = getMidnight(2020, 2, 12) + 15 * HOUR_DURATION + 20 * MINUTE_DURATION;
+    EXPECT_EQ(Interval::fromString("15m").getBucketStart(date), date - 5 * MINUTE_DURATION);
+    EXPECT_EQ(Interval::fromString("4h").getBucketStart(date), getMidnight(2020, 2, 12) + 12 * HOUR_DURATION);
+    EXPECT_EQ(DAY_INTERVAL.getBucketStart(date), getMidnight(2020, 2, 12));
+    EXPECT_EQ(DAY_INTERVAL.getBucketEnd(date), getMidnight(2020, 2, 13));
+    EXPECT_EQ(WEEK_INTERVAL.getBucketStart(date), getMidnight(2020, 2, 10));
+    EXPECT_EQ(WEEK_INTERVAL.getBucketEnd(date), getMidnight(2020, 2, 17));
+    EXPECT_EQ(MONTH_INTERVAL.getBucketStart(date), getMidnight(2020, 2, 1));
+    EXPECT_EQ(MONTH_INTERVAL.getBucketEnd(date), getMidnight(2020, 3, 1));
+    EXPECT_EQ(Interval::fromString("3mo").getBucketStart(date), getMidnight(2020, 1, 1));
+    EXPECT_EQ(Interval::fromString("3mo").getBucketEnd(date), getMidnight(2020, 4, 1));
+    EXPECT_EQ(YEAR_INTERVAL.getBucketStart(date), getMidnight(2020, 1, 1));
+    EXPECT_EQ(YEAR_INTERVAL.getBucketEnd(date), getMidnight(2021, 1, 1));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "timeseries/validation.hpp"
+
+#include <random>
+
+class ValidationTest : public testing::Test {
+protected:
+    ValidationTest() {
+        // AR(1) process with unit noise
+        std::mt19937 rng(39);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        double x1 = 5.0;
+        for (int i = 0; i < 600; ++i) {
+            double x = 1.0 + 0.8 * x1 + noise(rng);
+            values.push_back(x);
+            x1 = x;
+        }
+    }
+
+    std::vector<double> values;
+};
+
+TEST_F(ValidationTest, BlockedCrossValidation) {
+    CrossValidationConfig config;
+    config.folds = 5;
+    config.gap = 10;
+    config.threadCount = 4;
+    auto result = crossValidate(values, ModelType::AR, 1, 0, config);
+
+    ASSERT_EQ(result.size(), 5);
+    EXPECT_EQ(result.paramCount, 2);
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(result.testStarts[i], 100 * (i + 1));
+        EXPECT_EQ(result.testCounts[i], 100);
+        EXPECT_EQ(result.trainCounts[i], 100 * (i + 1) - 10);
+        EXPECT_NEAR(result.getParams(i)[1], 0.8, 0.15);
+        EXPECT_NEAR(result.rmse[i], 1.0, 0.25);
+    }
+    EXPECT_NEAR(result.pooledRMSE, 1.0, 0.1);
+    EXPECT_LT(result.pooledMAE, result.pooledRMSE);
+    EXPECT_NE(result.toString().find("AR(1) Blocked Cross-Validation"), std::string::npos);
+
+    // Folds are independent of the thread count
+    config.threadCount = 1;
+    auto serial = crossValidate(values, ModelType::AR, 1, 0, config);
+    EXPECT_EQ(serial.params, result.params);
+    EXPECT_EQ(serial.rmse, result.rmse);
+}
+
+TEST_F(ValidationTest, CrossValidationOrders) {
+    // Orders unused by the model type are ignored, and the last fold takes
+    // the remainder
+    CrossValidationConfig config;
+    config.folds = 7;
+    auto result = crossValidate(values, ModelType::MA, 3, 1, config);
+    EXPECT_EQ(result.arOrder, 0);
+    EXPECT_EQ(result.paramCount, 2);
+    EXPECT_EQ(result.testCounts.back(), 600 - 7 * 75);
+}
+
+TEST_F(ValidationTest, BlockBootstrap) {
+    BootstrapConfig config;
+    config.replications = 100;
+    config.seed = 7;
+    config.threadCount = 4;
+    auto result = bootstrapParams(values, ModelType::AR, 1, 0, config);
+
+    ASSERT_EQ(result.size(), 100);
+    ASSERT_EQ(result.stdErr.size(), 2);
+    double phi = result.estimate.phis[0];
+    EXPECT_NEAR(phi, 0.8, 0.1);
+    EXPECT_LT(result.lower[1], phi);
+    EXPECT_GT(result.upper[1], phi);
+    EXPECT_GT(result.stdErr[1], 0.005);
+    EXPECT_LT(result.stdErr[1], 0.1);
+    EXPECT_NE(result.toString().find("phi_1"), std::string::npos);
+
+    // Same seed, same distribution whatever the thread count
+    config.threadCount = 1;
+    auto serial = bootstrapParams(values, ModelType::AR, 1, 0, config);
+    EXPECT_EQ(serial.params, result.params);
+    config.seed = 8;
+    EXPECT_NE(bootstrapParams(values, ModelType::AR, 1, 0, config).params, result.params);
+}
+
+TEST_F(ValidationTest, InvalidArguments) {
+    CrossValidationConfig cvConfig;
+    cvConfig.folds = 0;
+    EXPECT_THROW(crossValidate(values, ModelType::AR, 1, 0, cvConfig), std::invalid_argument);
+    cvConfig.folds = 5;
+    cvConfig.gap = 100;
+    EXPECT_THROW(crossValidate(values, ModelType::AR, 1, 0, cvConfig), std::invalid_argument);
+    EXPECT_THROW(crossValidate(values, ModelType::AR, -1, 0), std::invalid_argument);
+
+    BootstrapConfig config;
+    config.replications = 1;
+    EXPECT_THROW(bootstrapParams(values, ModelType::AR, 1, 0, config), std::invalid_argument);
+    config.replications = 10;
+    config.level = 1.0;
+    EXPECT_THROW(bootstrapParams(values, ModelType::AR, 1, 0, config), std::invalid_argument);
+    config.level = 0.9;
+    config.blockLength = 600;
+    EXPECT_THROW(bootstrapParams(values, ModelType::AR, 1, 0, config), std::invalid_argument);
+    EXPECT_THROW(bootstrapParams({1.0, 2.0}, ModelType::AR, 1, 0), std::invalid_argument);
+}
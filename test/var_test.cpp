@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "timeseries/var.hpp"
+
+#include <random>
+
+class VARTest : public testing::Test {
+protected:
+    VARTest() {
+        // Simulated VAR(2) of three series
+        c << 0.5, -0.2, 1.0;
+        a1 << 0.5, 0.1, 0.0,
+              0.2, 0.3, -0.1,
+              0.0, 0.1, 0.4;
+        a2 << -0.2, 0.0, 0.1,
+               0.0, 0.1, 0.0,
+               0.1, 0.0, -0.1;
+
+        std::mt19937 rng(37);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        values = Eigen::MatrixXd::Zero(5000, 3);
+        for (Eigen::Index t = 2; t < values.rows(); ++t) {
+            Eigen::Vector3d e(noise(rng), noise(rng), noise(rng));
+            values.row(t) = (c + a1 * values.row(t - 1).transpose() + a2 * values.row(t - 2).transpose() + e).transpose();
+        }
+    }
+
+    Eigen::Vector3d c;
+    Eigen::Matrix3d a1;
+    Eigen::Matrix3d a2;
+    Eigen::MatrixXd values;
+};
+
+TEST_F(VARTest, RecoversCoefficients) {
+    VAR model(values);
+    model.train(2);
+    EXPECT_EQ(model.getLagOrder(), 2);
+    EXPECT_LT((model.getLagMatrix(1) - a1).cwiseAbs().maxCoeff(), 0.05);
+    EXPECT_LT((model.getLagMatrix(2) - a2).cwiseAbs().maxCoeff(), 0.05);
+    EXPECT_LT((model.getIntercepts() - c).cwiseAbs().maxCoeff(), 0.1);
+
+    // Unit innovations
+    for (double rmse : model.getRMSE()) {
+        EXPECT_NEAR(rmse, 1.0, 0.05);
+    }
+    EXPECT_LT((model.getResidualCovariance() - Eigen::Matrix3d::Identity()).cwiseAbs().maxCoeff(), 0.06);
+    EXPECT_EQ(model.getResiduals().rows(), values.rows() - 2);
+}
+
+TEST_F(VARTest, MatchesLeastSquares) {
+    // Blocked normal equations agree with a direct solve on the full lag matrix
+    const Eigen::Index n = 700;
+    Eigen::MatrixXd x(n - 2, 7);
+    x.col(0).setOnes();
+    x.middleCols(1, 3) = values.block(1, 0, n - 2, 3);
+    x.middleCols(4, 3) = values.block(0, 0, n - 2, 3);
+    Eigen::MatrixXd expected = x.colPivHouseholderQr().solve(values.block(2, 0, n - 2, 3));
+
+    VAR model(values.topRows(n));
+    model.train(2);
+    EXPECT_LT((model.getCoefficients() - expected).cwiseAbs().maxCoeff(), 1e-9);
+    EXPECT_LT((model.getResiduals() - (values.block(2, 0, n - 2, 3) - x * expected)).cwiseAbs().maxCoeff(), 1e-9);
+}
+
+TEST_F(VARTest, Forecast) {
+    VAR model(values);
+    model.train(2);
+    Eigen::MatrixXd forecast = model.forecast(50);
+    ASSERT_EQ(forecast.rows(), 50);
+    ASSERT_EQ(forecast.cols(), 3);
+
+    // Manual recursion on the fitted matrices
+    Eigen::VectorXd intercepts = model.getIntercepts();
+    Eigen::MatrixXd l1 = model.getLagMatrix(1);
+    Eigen::MatrixXd l2 = model.getLagMatrix(2);
+    Eigen::VectorXd previous = values.row(values.rows() - 2).transpose();
+    Eigen::VectorXd last = values.row(values.rows() - 1).transpose();
+    for (int h = 0; h < 50; ++h) {
+        Eigen::VectorXd next = intercepts + l1 * last + l2 * previous;
+        EXPECT_LT((forecast.row(h).transpose() - next).cwiseAbs().maxCoeff(), 1e-10);
+        previous = last;
+        last = next;
+    }
+
+    // Converges to the unconditional mean
+    Eigen::Matrix3d identity = Eigen::Matrix3d::Identity();
+    Eigen::VectorXd mean = (identity - l1 - l2).inverse() * intercepts;
+    EXPECT_LT((model.forecast(500).row(499).transpose() - mean).cwiseAbs().maxCoeff(), 1e-8);
+}
+
+TEST_F(VARTest, AlignsSeries) {
+    // Series with gaps only share some dates
+    std::vector<TimeSeries<double>> series(3);
+    for (Eigen::Index t = 0; t < values.rows(); ++t) {
+        for (int j = 0; j < 3; ++j) {
+            if (t % 7 != j) {
+                series[j][86400 * t] = values(t, j);
+            }
+        }
+    }
+    series[1][-86400] = 1.0;
+
+    VAR model(series, {"A", "B", "C"});
+    EXPECT_EQ(model.getNames()[1], "B");
+    std::size_t shared = 0;
+    for (Eigen::Index t = 0; t < values.rows(); ++t) {
+        shared += t % 7 >= 3;
+    }
+    ASSERT_EQ(model.getCount(), shared);
+    for (std::size_t i = 0; i < model.getCount(); ++i) {
+        std::time_t date = model.getDates()[i];
+        Eigen::Index t = date / 86400;
+        EXPECT_GE(t % 7, 3);
+        EXPECT_EQ(model.getValues().row(i), values.row(t));
+    }
+
+    model.train(1);
+    TimeSeries<double> forecasted = model.getForecasted(2, 5);
+    ASSERT_EQ(forecasted.size(), 5);
+    EXPECT_EQ(forecasted.begin()->first, model.getDates().back() + 86400);
+    EXPECT_EQ(forecasted.begin()->second, model.forecast(1)(0, 2));
+    EXPECT_NE(model.toString().find("VAR(1) Model of 3 Series"), std::string::npos);
+
+    // Forecast dates step by the median gap, hourly bars with overnight gaps
+    std::vector<std::time_t> hours;
+    for (Eigen::Index t = 0; t < values.rows(); ++t) {
+        hours.push_back(86400 * (t / 8) + 3600 * (t % 8));
+    }
+    VAR hourly(values, hours);
+    hourly.train(1);
+    EXPECT_EQ(hourly.getSpacing(), 3600);
+    forecasted = hourly.getForecasted(0, 3);
+    EXPECT_EQ(forecasted.rbegin()->first, hours.back() + 3 * 3600);
+}
+
+TEST_F(VARTest, ManySeries) {
+    // Dozens of independent AR(1) series, the solve stays on the diagonal
+    const int k = 40;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    Eigen::MatrixXd wide = Eigen::MatrixXd::Zero(3000, k);
+    for (Eigen::Index t = 1; t < wide.rows(); ++t) {
+        for (int j = 0; j < k; ++j) {
+            wide(t, j) = 0.6 * wide(t - 1, j) + noise(rng);
+        }
+    }
+    VAR model(wide);
+    model.train(3);
+    Eigen::MatrixXd a1 = model.getLagMatrix(1);
+    EXPECT_LT((a1.diagonal().array() - 0.6).abs().maxCoeff(), 0.1);
+    EXPECT_LT((a1 - Eigen::MatrixXd(a1.diagonal().asDiagonal())).cwiseAbs().maxCoeff(), 0.1);
+    EXPECT_EQ(model.forecast(10).cols(), k);
+}
+
+TEST_F(VARTest, InvalidArguments) {
+    EXPECT_THROW(VAR(Eigen::MatrixXd(10, 0)), std::invalid_argument);
+    EXPECT_THROW(VAR(values, {0, 1}), std::invalid_argument);
+    EXPECT_THROW(VAR(values, {}, {"A"}), std::invalid_argument);
+    EXPECT_THROW(VAR(std::vector<TimeSeries<double>>{}), std::invalid_argument);
+
+    VAR model(values.topRows(10));
+    EXPECT_THROW(model.forecast(1), std::runtime_error);
+    EXPECT_THROW(model.getLagMatrix(1), std::runtime_error);
+    EXPECT_THROW(model.getForecasted(5, 1), std::invalid_argument);
+    EXPECT_THROW(model.train(0), std::invalid_argument);
+    EXPECT_THROW(model.train(3), std::invalid_argument);
+    model.train(1);
+    EXPECT_THROW(model.getLagMatrix(2), std::invalid_argument);
+    EXPECT_THROW(model.forecast(-1), std::invalid_argument);
+    EXPECT_THROW(model.getForecasted(0, 1), std::runtime_error);
+}
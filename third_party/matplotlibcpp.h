@@ -13,8 +13,11 @@
 #include <stdexcept>
 #include <iostream>
 #include <cstdint> // <cstdint> requires c++11 support
+#include <cstring>
+#include <ctime>
 #include <functional>
 #include <string> // std::stod
+#include <type_traits>
 
 #define WITHOUT_NUMPY
 
@@ -400,16 +403,44 @@ PyObject* get_2darray(const std::vector<::std::vector<Numeric>>& v)
     return reinterpret_cast<PyObject *>(varray);
 }
 
-#else // fallback if we don't have numpy: copy every element of the given vector
+#else // fallback if we don't have numpy: copy the given vector into an array('d')
 
+// Values cross as one array.array('d') filled by a single copy of a double
+// buffer, rather than a list of one Python float per element
 template<typename Numeric>
 PyObject* get_array(const std::vector<Numeric>& v)
 {
-    PyObject* list = PyList_New(v.size());
-    for(size_t i = 0; i < v.size(); ++i) {
-        PyList_SetItem(list, i, PyFloat_FromDouble(v.at(i)));
+    static PyObject* array_type = nullptr;
+    if (!array_type) {
+        PyObject* array_module = PyImport_ImportModule("array");
+        if (!array_module) throw std::runtime_error("Error loading module array!");
+        array_type = PyObject_GetAttrString(array_module, "array");
+        Py_DECREF(array_module);
+        if (!array_type) throw std::runtime_error("Couldn't find required function: array");
     }
-    return list;
+
+    std::vector<double> converted;
+    const double* values;
+    if constexpr (std::is_same<Numeric, double>::value) {
+        values = v.data();
+    } else {
+        converted.assign(v.begin(), v.end());
+        values = converted.data();
+    }
+
+    PyObject* array = PyObject_CallFunction(array_type, "s", "d");
+    if (!array) throw std::runtime_error("Call to array() failed.");
+    PyObject* buffer = PyMemoryView_FromMemory(
+        const_cast<char*>(reinterpret_cast<const char*>(values)),
+        static_cast<Py_ssize_t>(v.size() * sizeof(double)), PyBUF_READ);
+    PyObject* res = buffer ? PyObject_CallMethod(array, "frombytes", "O", buffer) : nullptr;
+    Py_XDECREF(buffer);
+    if (!res) {
+        Py_DECREF(array);
+        throw std::runtime_error("Call to array.frombytes() failed.");
+    }
+    Py_DECREF(res);
+    return array;
 }
 
 #endif // WITHOUT_NUMPY
@@ -437,9 +468,119 @@ PyObject* get_listlist(const std::vector<std::vector<Numeric>>& ll)
 
 } // namespace detail
 
-// This really shouldn't be here, but no simpler way to avoid multiple Python interpreters for now
-inline bool scrape(const std::string ticker, 
-                   const std::string start, 
+// Columns of one scraped ticker, dates are wall clock seconds since 1970
+struct scraped_series {
+    std::vector<std::time_t> dates;
+    std::vector<double> opens;
+    std::vector<double> highs;
+    std::vector<double> lows;
+    std::vector<double> closes;
+    std::vector<double> adj_closes;
+    std::vector<long> volumes;
+};
+
+namespace detail {
+
+// Look up one of the scraper's Python functions, defining them on first use
+inline PyObject* scrape_function(const char* name)
+{
+    static bool defined = false;
+    if (!defined) {
+        const char* scrape_src = R"(
+import numpy as np
+
+def get_frame_columns(data):
+    data = data[1:]
+
+    def column(name, dtype):
+        values = data[name]
+        if values.ndim == 2:
+            values = values.iloc[:, 0]
+        return np.ascontiguousarray(values.to_numpy(dtype=dtype))
+
+    index = data.index
+    if index.tz is not None:
+        index = index.tz_localize(None)
+    dates = np.ascontiguousarray(index.values.astype('datetime64[s]').astype(np.int64))
+    return (dates, column('Open', np.float64), column('High', np.float64),
+            column('Low', np.float64), column('Close', np.float64),
+            column('Adj Close', np.float64), column('Volume', np.int64))
+
+def get_columns(ticker, start_date, end_date):
+    import yfinance as yf
+    return get_frame_columns(yf.download(ticker, start=start_date, end=end_date, auto_adjust=False))
+
+def get_batch_columns(tickers, start_date, end_date):
+    import yfinance as yf
+    data = yf.download(tickers, start=start_date, end=end_date, auto_adjust=False, group_by='ticker')
+    batch = []
+    for ticker in tickers:
+        frame = data[ticker] if data.columns.nlevels > 1 else data
+        batch.append(get_frame_columns(frame.dropna(how='all')))
+    return batch
+)";
+        if (PyRun_SimpleString(scrape_src) != 0) {
+            throw std::runtime_error("Error defining scraper, is numpy installed?");
+        }
+        defined = true;
+    }
+
+    PyObject* main_module = PyImport_AddModule("__main__");
+    PyObject* function = PyDict_GetItemString(PyModule_GetDict(main_module), name);
+    if (!function || !PyCallable_Check(function)) {
+        throw std::runtime_error(std::string("Couldn't find required function: ") + name);
+    }
+    return function;
+}
+
+// Copy a contiguous buffer of Source values (e.g. a numpy array) into out,
+// with a single memcpy when the element types match
+template<typename Target, typename Source>
+void copy_buffer(PyObject* column, std::vector<Target>& out)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(column, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        PyErr_Clear();
+        throw std::runtime_error("Scraped column does not support the buffer protocol.");
+    }
+    if (view.itemsize != static_cast<Py_ssize_t>(sizeof(Source))) {
+        PyBuffer_Release(&view);
+        throw std::runtime_error("Scraped column has an unexpected element size.");
+    }
+    const std::size_t n = view.len / sizeof(Source);
+    const Source* values = static_cast<const Source*>(view.buf);
+    if constexpr (std::is_same<Target, Source>::value) {
+        out.resize(n);
+        if (n > 0) std::memcpy(out.data(), values, n * sizeof(Source));
+    } else {
+        out.assign(values, values + n);
+    }
+    PyBuffer_Release(&view);
+}
+
+// Copy the (dates, open, high, low, close, adj close, volume) arrays
+// returned by get_frame_columns
+inline void copy_columns(PyObject* columns, scraped_series& series)
+{
+    if (!columns || !PyTuple_Check(columns) || PyTuple_Size(columns) != 7) {
+        throw std::runtime_error("Scraper returned an unexpected value.");
+    }
+    copy_buffer<std::time_t, std::int64_t>(PyTuple_GetItem(columns, 0), series.dates);
+    copy_buffer<double, double>(PyTuple_GetItem(columns, 1), series.opens);
+    copy_buffer<double, double>(PyTuple_GetItem(columns, 2), series.highs);
+    copy_buffer<double, double>(PyTuple_GetItem(columns, 3), series.lows);
+    copy_buffer<double, double>(PyTuple_GetItem(columns, 4), series.closes);
+    copy_buffer<double, double>(PyTuple_GetItem(columns, 5), series.adj_closes);
+    copy_buffer<long, std::int64_t>(PyTuple_GetItem(columns, 6), series.volumes);
+}
+
+} // namespace detail
+
+// This really shouldn't be here, but no simpler way to avoid multiple Python interpreters for now.
+// Each column comes back as a contiguous numpy array and is copied straight
+// from its buffer, dates are wall clock seconds since 1970.
+inline bool scrape(const std::string ticker,
+                   const std::string start,
                    const std::string end,
                    std::vector<std::time_t>& dates,
                    std::vector<double>& opens,
@@ -448,67 +589,71 @@ inline bool scrape(const std::string ticker,
                    std::vector<double>& closes,
                    std::vector<double>& adjCloses,
                    std::vector<long>& volumes) {
-    detail::_interpreter::get(); // TODO: Needed?
-
-    // Register new function 
-    const char* scrape_src = R"(
-import yfinance as yf
-
-def get_data(ticker, start_date, end_date):
-    data = yf.download(ticker, start=start_date, end=end_date)
-
-    return data.reset_index().values[1:].tolist()
-)";
-
-    // Run code to define the function
-    PyRun_SimpleString(scrape_src);
+    detail::_interpreter::get();
 
-    // Get the global dictionary 
-    PyObject* main_module = PyImport_AddModule("__main__");
-    PyObject* global_dict = PyModule_GetDict(main_module);
+    PyObject* scrape_func = detail::scrape_function("get_columns");
+    PyObject* args = Py_BuildValue("(sss)", ticker.c_str(), start.c_str(), end.c_str());
+    PyObject* result = PyObject_CallObject(scrape_func, args);
+    Py_DECREF(args);
+    if (!result) {
+        PyErr_Print();
+        throw std::runtime_error("Call to get_columns() failed.");
+    }
 
-    // Get the function
-    PyObject* scrape_func = PyDict_GetItemString(global_dict, "get_data");
+    scraped_series series;
+    try {
+        detail::copy_columns(result, series);
+    } catch (...) {
+        Py_DECREF(result);
+        throw;
+    }
+    Py_DECREF(result);
+
+    dates = std::move(series.dates);
+    opens = std::move(series.opens);
+    highs = std::move(series.highs);
+    lows = std::move(series.lows);
+    closes = std::move(series.closes);
+    adjCloses = std::move(series.adj_closes);
+    volumes = std::move(series.volumes);
+    return 1;
+}
 
-    if (scrape_func && PyCallable_Check(scrape_func)) {
-        // Prepare args 
-        PyObject* args = PyTuple_Pack(3,
-            PyUnicode_FromString(ticker.c_str()),
-            PyUnicode_FromString(start.c_str()),
-            PyUnicode_FromString(end.c_str()));
+// Download every ticker in one request, calling on_series(i, columns) for
+// tickers[i] as soon as its columns have been copied
+inline void scrape_batch(const std::vector<std::string>& tickers,
+                         const std::string& start,
+                         const std::string& end,
+                         const std::function<void(std::size_t, scraped_series&)>& on_series) {
+    detail::_interpreter::get();
 
-        PyObject* result = PyObject_CallObject(scrape_func, args);
-        Py_DECREF(args);
+    PyObject* scrape_func = detail::scrape_function("get_batch_columns");
+    PyObject* list = PyList_New(tickers.size());
+    for (std::size_t i = 0; i < tickers.size(); ++i) {
+        PyList_SetItem(list, i, PyString_FromString(tickers[i].c_str()));
+    }
+    PyObject* args = Py_BuildValue("(Nss)", list, start.c_str(), end.c_str());
+    PyObject* result = PyObject_CallObject(scrape_func, args);
+    Py_DECREF(args);
+    if (!result) {
+        PyErr_Print();
+        throw std::runtime_error("Call to get_batch_columns() failed.");
+    }
 
-        if (PyList_Check(result)) {
-
-            // Iterate through list and convert to C++ vectors
-            Py_ssize_t num_rows = PyList_Size(result);
-            for (Py_ssize_t i = 0; i < num_rows; i++) {
-                PyObject* row = PyList_GetItem(result, i);
-                if (PyList_Check(row)) {
-                    if (PyList_Size(row) >= 7)  { // Ensure there are enough columns
-                        PyObject* date_obj = PyList_GetItem(row, 0);
-                        PyDateTime_DateTime* date = reinterpret_cast<PyDateTime_DateTime*>(date_obj);
-                        std::tm time = {};
-                        time.tm_year = PyDateTime_GET_YEAR(date) - 1900;
-                        time.tm_mon = PyDateTime_GET_MONTH(date) - 1;
-                        time.tm_mday = PyDateTime_GET_DAY(date);
-                        dates.push_back(std::mktime(&time));
-
-                        opens.push_back(PyFloat_AsDouble(PyList_GetItem(row, 1)));
-                        highs.push_back(PyFloat_AsDouble(PyList_GetItem(row, 2)));
-                        lows.push_back(PyFloat_AsDouble(PyList_GetItem(row, 3)));
-                        closes.push_back(PyFloat_AsDouble(PyList_GetItem(row, 4)));
-                        adjCloses.push_back(PyFloat_AsDouble(PyList_GetItem(row, 5)));
-                        volumes.push_back(PyLong_AsLong(PyList_GetItem(row, 6)));
-                    }
-                }
-            }
+    try {
+        if (!PyList_Check(result) || PyList_Size(result) != static_cast<Py_ssize_t>(tickers.size())) {
+            throw std::runtime_error("get_batch_columns() returned an unexpected value.");
+        }
+        for (std::size_t i = 0; i < tickers.size(); ++i) {
+            scraped_series series;
+            detail::copy_columns(PyList_GetItem(result, i), series);
+            on_series(i, series);
         }
+    } catch (...) {
         Py_DECREF(result);
+        throw;
     }
-    return 1;
+    Py_DECREF(result);
 }
 
 